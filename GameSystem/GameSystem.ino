@@ -4,26 +4,58 @@
 #include "input.h"
 #include "gamemanager.h"
 #include "highscore.h"
+#include "benchmark.h"
+#include "replay.h"
+#include "frameclock.h"
+#include "framescheduler.h"
+#include "profiler.h"
+#include "boot.h"
 
 
 void intro(){
   display.clearDisplay();
-  display.drawBitmap(0, 0, epd_bitmap_Intro, 128, 64, 1);
-  display.display();
+  display.drawAsset(assetIntro, 0, 0);
+  updateDisplay();
 }
 void setup() {
+  bootSequence.begin();
   Serial.begin(115200);
+  frameClock.begin(HEADLESS);
   initDisplay();
+  bootSequence.endStage(BOOT_DISPLAY);
+#if ENABLE_BENCHMARKS
+  runBenchmarks();
+  bootSequence.endStage(BOOT_BENCHMARKS);
+#endif
+  // The rest loads behind the intro, loop() waits out what is left of it
   intro();
-  delay(12000);
+  bootSequence.endStage(BOOT_INTRO);
   initInput();
+  initReplay();
+  bootSequence.endStage(BOOT_INPUT);
   initHighscores();
-  initGameManager();
+  bootSequence.endStage(BOOT_HIGHSCORES);
 }
 
 void loop() {
-
-  updateInput();
-  updateGameManager();
-  delay(16); // ~60 FPS
+  if (!bootSequence.isDone()) {
+    if (!bootSequence.introOver()) return;
+    initGameManager();
+    frameScheduler.begin();
+    bootSequence.finish();
+    return;
+  }
+  
+  // Game logic runs in fixed ticks, the frame is drawn once after them
+  uint8_t ticks = frameScheduler.dueTicks();
+  for (uint8_t i = 0; i < ticks; i++) {
+    frameClock.advance(GAME_TICK_MS);
+    updateInput();
+    updateGameManager();
+  }
+  if (ticks > 0) {
+    renderGameManager();
+    PROFILE_END_FRAME();
+  }
+  frameScheduler.sleep();
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+// Generated by tools/make_assets.py, do not edit
+#include "assets.h"
+
+// Intro, 128x64, 732 bytes packed from 1024
+const uint8_t introData[] PROGMEM = {
+  0xF5, 0xFF, 0x01, 0xCF, 0xE7, 0xFB, 0x67, 0x02, 0xCF, 0x9F, 0x3F, 0xFD, 0x7F, 0x00, 0xEF, 0xFE,
+  0xFF, 0x00, 0xDF, 0xEA, 0xFF, 0x01, 0x7F, 0xFF, 0xF9, 0x3F, 0x00, 0x7F, 0xFA, 0xFF, 0x00, 0xEF,
+  0xF8, 0xFF, 0x00, 0xBF, 0xFD, 0xFF, 0x00, 0xDF, 0xF8, 0xFF, 0xFF, 0x7F, 0xFF, 0xBF, 0xFB, 0xDF,
+  0x02, 0x9F, 0x3F, 0x7F, 0xFE, 0xFF, 0x09, 0x07, 0xF7, 0x17, 0x17, 0x97, 0xB7, 0x67, 0xCF, 0x9F,
+  0x7F, 0xEF, 0xFF, 0x00, 0x00, 0xFD, 0xFF, 0x05, 0xFE, 0xFC, 0xF1, 0xC7, 0x8E, 0xC6, 0xFE, 0xF6,
+  0x02, 0xF4, 0xF5, 0x0D, 0xFD, 0xF5, 0x00, 0x05, 0xFD, 0xF5, 0x03, 0xC5, 0x1D, 0x3D, 0x0D, 0xFD,
+  0xED, 0x00, 0x0D, 0xFD, 0xED, 0x03, 0x0D, 0xCE, 0xE7, 0xF3, 0xFB, 0xFB, 0xFF, 0xF3, 0x03, 0xE6,
+  0x1C, 0x19, 0xCB, 0xFC, 0xC9, 0xFF, 0x1B, 0xFE, 0xDB, 0x04, 0x9B, 0x3B, 0x77, 0x3B, 0x9B, 0xFE,
+  0xDB, 0x02, 0x19, 0x9C, 0xEC, 0xFB, 0xE4, 0x1B, 0x0C, 0x3C, 0x0E, 0xC7, 0xF3, 0xF9, 0xFC, 0xFC,
+  0x7C, 0x7C, 0xFC, 0xF9, 0xF3, 0xE7, 0xCE, 0x1C, 0x39, 0xF3, 0xE8, 0xDB, 0xF2, 0xC6, 0xDC, 0xD0,
+  0xD1, 0xD0, 0xDF, 0xC0, 0xFC, 0xFF, 0xF6, 0xD7, 0xFF, 0xFF, 0x00, 0x00, 0xF7, 0xFF, 0x00, 0x7F,
+  0xFD, 0xFF, 0x00, 0x00, 0xFD, 0xFF, 0x00, 0x00, 0xFB, 0xFF, 0x01, 0xF8, 0xF0, 0xFD, 0xFF, 0x00,
+  0x00, 0xFD, 0xFF, 0x00, 0x00, 0xFD, 0xFF, 0x03, 0x03, 0x01, 0xF1, 0xF3, 0xFE, 0xF7, 0x05, 0x01,
+  0x00, 0xFC, 0xFF, 0xFF, 0x1F, 0xFE, 0xFF, 0x01, 0xE0, 0x00, 0xFE, 0xFF, 0x04, 0x7F, 0xFE, 0xFC,
+  0xFE, 0x7F, 0xFE, 0xFF, 0x00, 0x00, 0xFD, 0xFF, 0xFE, 0xF9, 0x15, 0x01, 0x00, 0x00, 0x07, 0x1F,
+  0x1F, 0x3F, 0x7F, 0xFF, 0xF8, 0xF8, 0xF0, 0xE1, 0xC7, 0x87, 0x03, 0x01, 0xC0, 0xE0, 0xFF, 0xFF,
+  0xDF, 0xF8, 0xD7, 0x00, 0xDF, 0xF2, 0xFF, 0x15, 0x00, 0x7F, 0x7F, 0x5F, 0x1F, 0x7F, 0x00, 0x00,
+  0xC1, 0x83, 0x81, 0x00, 0x2F, 0x5F, 0x7F, 0x3F, 0x00, 0x3F, 0x5F, 0x7F, 0x3F, 0x00, 0xFD, 0x7F,
+  0x03, 0x01, 0xC3, 0x0F, 0x1F, 0xFD, 0x7F, 0x0A, 0x00, 0x7F, 0x0F, 0x1F, 0x7F, 0x00, 0x1F, 0x2F,
+  0x7F, 0x7F, 0x7E, 0xFE, 0x7C, 0x08, 0x7F, 0x3F, 0x3F, 0x00, 0x7C, 0x7F, 0x7F, 0x07, 0x07, 0xFD,
+  0x7F, 0x0C, 0x00, 0x7F, 0x7F, 0x3F, 0x00, 0x03, 0x03, 0x81, 0x00, 0x7F, 0x7F, 0x1F, 0x00, 0xFD,
+  0x7F, 0xFD, 0x78, 0xFF, 0x00, 0x06, 0x3C, 0x7E, 0xFE, 0xFC, 0xFC, 0xF8, 0xF1, 0xFB, 0xFF, 0xFF,
+  0x00, 0x00, 0x01, 0xF2, 0xFF, 0xF6, 0x5F, 0x0E, 0x5B, 0x5F, 0x4F, 0x7E, 0x7C, 0xF0, 0xE0, 0xC0,
+  0x80, 0x80, 0x8F, 0xBF, 0xFF, 0xFE, 0xFC, 0xFE, 0xF8, 0x01, 0x1C, 0x18, 0xFE, 0xF8, 0x01, 0xFE,
+  0xFC, 0xFD, 0xF8, 0xFF, 0xFF, 0x00, 0xFC, 0xFD, 0xF8, 0xFF, 0xFC, 0xFF, 0xF8, 0xFF, 0x18, 0x01,
+  0xFE, 0xFC, 0xF9, 0xF8, 0x01, 0xFC, 0xFE, 0xFE, 0xF8, 0x01, 0xFC, 0xFE, 0xF8, 0xF8, 0x18, 0xFC,
+  0xFF, 0xFF, 0xFE, 0xFC, 0xF8, 0x18, 0x18, 0xFC, 0xFE, 0xF8, 0x18, 0x1C, 0x78, 0xF8, 0xF8, 0xFC,
+  0xFF, 0xFE, 0xFC, 0xF8, 0xF1, 0xE3, 0xC7, 0x87, 0xFE, 0x07, 0x08, 0x87, 0xC3, 0xC1, 0x60, 0xF0,
+  0x79, 0x7F, 0x5F, 0x5B, 0xF7, 0x5F, 0xFF, 0xFF, 0xFF, 0xFC, 0xFF, 0x7C, 0x01, 0xBC, 0x7C, 0xFC,
+  0xFC, 0x0B, 0x0C, 0xE0, 0x38, 0x08, 0x48, 0x4A, 0x19, 0x13, 0xF7, 0x07, 0xFF, 0x7F, 0xFB, 0xFF,
+  0xFF, 0x80, 0xFF, 0xFE, 0xFF, 0x80, 0x02, 0xFF, 0xCF, 0x84, 0xFE, 0xB6, 0x11, 0x80, 0x81, 0xFF,
+  0xC1, 0x80, 0x9C, 0xBE, 0x9C, 0xDC, 0xFF, 0x80, 0x80, 0xC3, 0xE3, 0x89, 0x9C, 0xBE, 0xFF, 0xFB,
+  0xBF, 0x1C, 0xFF, 0xC0, 0x80, 0x9F, 0x9F, 0x80, 0x80, 0xFF, 0xFF, 0x00, 0x00, 0x9E, 0x9C, 0x80,
+  0xC1, 0xFF, 0xC0, 0x80, 0x9C, 0x9E, 0x80, 0x80, 0xFF, 0xFF, 0xFE, 0xC0, 0x80, 0x9C, 0x9E, 0xFD,
+  0xFF, 0x00, 0xF7, 0xF9, 0xFF, 0xFF, 0xFD, 0xFF, 0xFC, 0x01, 0xDC, 0xBC, 0xF5, 0xFC, 0x17, 0xFE,
+  0xFF, 0x5D, 0x7D, 0xBE, 0xD7, 0xBF, 0x6F, 0x36, 0x1D, 0x13, 0xCF, 0xBF, 0x7F, 0xFC, 0xFD, 0xF9,
+  0xF3, 0xF6, 0xF5, 0xF6, 0xF3, 0xF9, 0xFC, 0xF3, 0xFF, 0xDD, 0xF7, 0xFE, 0xFF, 0x03, 0xEC, 0xFC,
+  0xFF, 0xFF, 0xFD, 0xF7, 0x08, 0x77, 0xB7, 0xB7, 0xD7, 0xD7, 0x97, 0xD7, 0xB7, 0x77, 0xFA, 0xFF,
+  0x10, 0x7F, 0xBF, 0x0F, 0xCF, 0x4F, 0x97, 0x4F, 0xE7, 0x37, 0xD7, 0x6F, 0x8F, 0x5F, 0xDE, 0x3F,
+  0xBF, 0x7F, 0xF5, 0xFF, 0x00, 0xE0, 0xFE, 0x00, 0x21, 0x80, 0xC0, 0xE4, 0xE6, 0x47, 0x85, 0x8F,
+  0x0C, 0x15, 0x1B, 0x1B, 0x37, 0x2F, 0x0F, 0x2F, 0xD7, 0xFB, 0xEB, 0xFD, 0x9E, 0x9D, 0x9B, 0x97,
+  0x0F, 0x1F, 0x3E, 0x3E, 0x7E, 0x7E, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xE5, 0xFF, 0x03, 0xFE, 0x7E,
+  0xBE, 0xBE, 0xFE, 0xDE, 0x2F, 0xBF, 0x3F, 0x3F, 0x0F, 0x37, 0x27, 0x03, 0x1D, 0x25, 0x0A, 0x33,
+  0x07, 0x0B, 0x16, 0x2B, 0x07, 0x1A, 0x23, 0x0B, 0x16, 0x2A, 0x11, 0x0D, 0x05, 0x13, 0x01, 0x00,
+  0x06, 0x01, 0x06, 0x11, 0x02, 0x05, 0x02, 0x05, 0x12, 0x01, 0x06, 0x01, 0x02, 0x15, 0x02, 0x01,
+  0x04, 0x01, 0x13, 0x03, 0x07, 0xFE, 0x0F, 0xFF, 0x1F, 0x01, 0x3F, 0x7F
+};
+const Asset assetIntro = {128, 64, introData};
+
+// Select, 128x10, 52 bytes packed from 160
+const uint8_t selectData[] PROGMEM = {
+  0x01, 0xFC, 0xFE, 0xAD, 0xFF, 0x06, 0xFE, 0xFC, 0x00, 0x00, 0xFC, 0xFE, 0xFE, 0xEC, 0xFF, 0xFF,
+  0xFE, 0x08, 0xFC, 0x00, 0x30, 0x48, 0x84, 0x02, 0x01, 0x01, 0xFE, 0xFD, 0x00, 0x00, 0x01, 0xAD,
+  0x03, 0x00, 0x01, 0xFD, 0x00, 0xFF, 0x01, 0xEC, 0x03, 0xFF, 0x01, 0xFC, 0x00, 0x03, 0x01, 0x02,
+  0x02, 0x01, 0xFE, 0x00
+};
+const Asset assetSelect = {128, 10, selectData};
+
+// GameHeader, 128x20, 163 bytes packed from 320
+const uint8_t gameHeaderData[] PROGMEM = {
+  0xDB, 0x00, 0x27, 0x02, 0xFF, 0x07, 0x07, 0x0A, 0x34, 0x3C, 0x1C, 0x18, 0xF8, 0x18, 0x18, 0xF8,
+  0x18, 0x38, 0xC8, 0xE8, 0x28, 0xE8, 0x28, 0x28, 0xE8, 0x30, 0x14, 0x94, 0x14, 0x34, 0xFC, 0x78,
+  0x30, 0x38, 0x78, 0xD0, 0x10, 0x50, 0xD0, 0xD0, 0x10, 0xD0, 0x48, 0xFE, 0x38, 0x0E, 0xE8, 0xEC,
+  0x34, 0x0A, 0x8A, 0x8A, 0x12, 0x24, 0xC8, 0xBE, 0x15, 0x2F, 0x3D, 0x3A, 0x18, 0xBE, 0x00, 0xFE,
+  0x02, 0x35, 0x00, 0xFF, 0x80, 0xC0, 0xF8, 0x70, 0x78, 0xE0, 0xC0, 0xFF, 0xC0, 0xC0, 0xFF, 0x80,
+  0xF0, 0x71, 0xC1, 0x80, 0xFF, 0xE0, 0xC0, 0xFF, 0xC0, 0x9F, 0x97, 0x87, 0xC6, 0xFF, 0x80, 0xE6,
+  0xE4, 0x80, 0xFF, 0x80, 0xF8, 0xF0, 0xF8, 0x80, 0xFF, 0xC0, 0x80, 0x99, 0x99, 0xFF, 0xDF, 0x8C,
+  0x18, 0x11, 0x01, 0x03, 0x07, 0xFF, 0x73, 0x00, 0xFE, 0x02, 0xC5, 0x00, 0xFF, 0x08, 0xF6, 0x0C,
+  0x04, 0x09, 0x03, 0x07, 0x06, 0x00, 0xFC, 0x01, 0x03, 0x00, 0x01, 0x01, 0x00, 0xEE, 0x01, 0xFF,
+  0x00, 0xFA, 0x01, 0x08, 0x00, 0x01, 0x03, 0x06, 0x0E, 0x06, 0x07, 0x0B, 0x09, 0xF7, 0x0C, 0x00,
+  0x08, 0xE7, 0x00
+};
+const Asset assetGameHeader = {128, 20, gameHeaderData};
@@ -0,0 +1,60 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "config.h"
+
+// Bitmap stored as PackBits runs of SSD1306 page columns: one byte per
+// column, bit 0 the top row, page after page, rows past the height zero.
+// Drawn with display.drawAsset(), which like drawBitmap() sets the white
+// pixels and leaves the rest alone.
+struct Asset {
+  uint8_t width;
+  uint8_t height;
+  const uint8_t* data;  // PROGMEM
+};
+
+// Decodes the column bytes of an asset in order. A run header n < 128 is
+// followed by n + 1 literal bytes, otherwise the next byte repeats 257 - n
+// times.
+class AssetStream {
+private:
+  const uint8_t* data;
+  uint8_t count;  // Bytes left in the current run
+  bool repeat;    // The current run is one repeated byte
+  
+  void startRun() {
+    uint8_t header = pgm_read_byte(data++);
+    repeat = header >= 128;
+    count = repeat ? 257 - header : header + 1;
+  }
+  
+public:
+  AssetStream(const Asset& asset) : data(asset.data), count(0), repeat(false) {}
+  
+  uint8_t next() {
+    if (count == 0) startRun();
+    count--;
+    if (!repeat) return pgm_read_byte(data++);
+    uint8_t value = pgm_read_byte(data);
+    if (count == 0) data++;
+    return value;
+  }
+  
+  void skip(uint16_t bytes) {
+    while (bytes > 0) {
+      if (count == 0) startRun();
+      uint8_t step = min((uint16_t)count, bytes);
+      count -= step;
+      bytes -= step;
+      if (!repeat) data += step;
+      else if (count == 0) data++;
+    }
+  }
+};
+
+// Generated by tools/make_assets.py
+extern const Asset assetIntro;
+extern const Asset assetSelect;
+extern const Asset assetGameHeader;
+
+#endif
@@ -0,0 +1,46 @@
+#include "background.h"
+
+BackgroundCache backgroundCache;
+
+BackgroundCache::BackgroundCache() {
+  valid = false;
+  resetStats();
+}
+
+bool BackgroundCache::restore() {
+  unsigned long start = micros();
+  
+#if BACKGROUND_CACHE_ENABLED
+  if (valid) {
+    memcpy(display.getBuffer(), pixels, DISPLAY_BUFFER_SIZE);
+    hitMicros += micros() - start;
+    hits++;
+    return true;
+  }
+#endif
+  
+  missStart = start;
+  return false;
+}
+
+void BackgroundCache::capture() {
+#if BACKGROUND_CACHE_ENABLED
+  memcpy(pixels, display.getBuffer(), DISPLAY_BUFFER_SIZE);
+  valid = true;
+#endif
+  missMicros += micros() - missStart;
+  misses++;
+}
+
+void BackgroundCache::resetStats() {
+  hits = 0;
+  misses = 0;
+  hitMicros = 0;
+  missMicros = 0;
+}
+
+long BackgroundCache::getSavedMicros() {
+  // Drawing cost avoided on every hit, minus what the copies took
+  if (misses == 0) return 0;
+  return (long)(missMicros / misses * hits) - (long)hitMicros;
+}
@@ -0,0 +1,41 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include "config.h"
+#include "display.h"
+
+#if USE_BACKGROUND_CACHE && !DISPLAY_PAGED
+#define BACKGROUND_CACHE_ENABLED 1
+#else
+#define BACKGROUND_CACHE_ENABLED 0
+#endif
+
+// Copy of a game's static background. A frame starts with restore(); when
+// that fails the game clears, draws its background and calls capture().
+// Games call invalidate() when the background content changes.
+class BackgroundCache {
+private:
+#if BACKGROUND_CACHE_ENABLED
+  uint8_t pixels[DISPLAY_BUFFER_SIZE];
+#endif
+  bool valid;
+  unsigned long missStart;
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long hitMicros;  // Time spent restoring
+  unsigned long missMicros; // Time spent drawing the background
+  
+public:
+  BackgroundCache();
+  void invalidate() { valid = false; }
+  bool restore();
+  void capture();
+  void resetStats();
+  unsigned long getHits() { return hits; }
+  unsigned long getMisses() { return misses; }
+  long getSavedMicros();
+};
+
+extern BackgroundCache backgroundCache;
+
+#endif
@@ -0,0 +1,512 @@
+#include "benchmark.h"
+
+#if ENABLE_BENCHMARKS
+#include "display.h"
+#include "text.h"
+#include "input.h"
+#include "tetris.h"
+#include "breakout.h"
+#include "helicopter.h"
+#include "pacman.h"
+#include "physics.h"
+#include "gamearena.h"
+
+#define BENCHMARK_ROUNDS 100
+#define INPUT_SAMPLE_ROUNDS 10000
+#define PHYSICS_STEPS 100000L
+#define DISPATCH_ROUNDS 100000L
+
+typedef void (*Workload)();
+
+struct BenchmarkWorkload {
+  const char* name;
+  Workload draw;
+};
+
+// Worst-case fill load of each game, whole screen busy
+
+static void tetrisWorkload() {
+  display.drawRect(TETRIS_OFFSET_X - 1, TETRIS_OFFSET_Y - 1,
+                   TETRIS_FIELD_WIDTH + 2, TETRIS_FIELD_HEIGHT + 2, SSD1306_WHITE);
+  for (int y = 0; y < TETRIS_HEIGHT; y++) {
+    for (int x = 0; x < TETRIS_WIDTH; x++) {
+      display.fillRect(TETRIS_OFFSET_X + x * BLOCK_SIZE, TETRIS_OFFSET_Y + y * BLOCK_SIZE,
+                       BLOCK_SIZE, BLOCK_SIZE, SSD1306_WHITE);
+    }
+  }
+}
+
+static void breakoutWorkload() {
+  for (int row = 0; row < BRICK_ROWS; row++) {
+    for (int col = 0; col < BRICK_COLS; col++) {
+      int x = col * BRICK_WIDTH + (SCREEN_WIDTH - BRICK_COLS * BRICK_WIDTH) / 2;
+      int y = BRICK_OFFSET_Y + row * (BRICK_HEIGHT + 1);
+      display.fillRect(x, y, BRICK_WIDTH - 1, BRICK_HEIGHT, SSD1306_WHITE);
+    }
+  }
+  display.fillRect(56, PADDLE_Y, PADDLE_WIDTH, PADDLE_HEIGHT, SSD1306_WHITE);
+}
+
+static void helicopterWorkload() {
+  for (int i = 0; i < CAVE_SEGMENTS; i++) {
+    int topHeight = 4 + (i * 7) % 13;
+    int bottomY = topHeight + 30 + (i * 5) % 11;
+    display.fillRect(i * 4, 0, 4, topHeight, SSD1306_WHITE);
+    display.fillRect(i * 4, bottomY, 4, SCREEN_HEIGHT - bottomY, SSD1306_WHITE);
+  }
+}
+
+static void pacmanWorkload() {
+  for (int y = 0; y < MAZE_HEIGHT; y++) {
+    for (int x = 0; x < MAZE_WIDTH; x++) {
+      bool border = x == 0 || y == 0 || x == MAZE_WIDTH - 1 || y == MAZE_HEIGHT - 1;
+      if (border || (x % 2 == 0 && y % 2 == 0)) {
+        display.fillRect(x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, SSD1306_WHITE);
+      }
+    }
+  }
+}
+
+static void menuWorkload() {
+  // Highlight bars inverted over a filled screen
+  display.fillScreen(SSD1306_WHITE);
+  for (int i = 0; i < 3; i++) {
+    display.fillRect(2, 13 + i * 17, SCREEN_WIDTH - 4, 15, SSD1306_INVERSE);
+  }
+}
+
+static const BenchmarkWorkload rasterWorkloads[] = {
+  {"TETRIS", tetrisWorkload},
+  {"BREAKOUT", breakoutWorkload},
+  {"HELICOPTER", helicopterWorkload},
+  {"PAC-MAN", pacmanWorkload},
+  {"MENU", menuWorkload}
+};
+
+// Pac-Man actors and dots over a full board, drawn from primitives as the
+// games used to and from the sprite atlas
+
+static void actorPrimitivesWorkload() {
+  for (int y = 0; y < MAZE_HEIGHT; y++) {
+    for (int x = 0; x < MAZE_WIDTH; x++) {
+      int screenX = x * CELL_SIZE + CELL_SIZE/2;
+      int screenY = y * CELL_SIZE + CELL_SIZE/2;
+      
+      switch ((x + y) % 4) {
+        case 0:
+          display.fillCircle(screenX, screenY, 1, SSD1306_WHITE);
+          break;
+        case 1:
+          display.fillCircle(screenX, screenY, 3, SSD1306_WHITE);
+          display.drawLine(screenX, screenY, screenX + 2, screenY - 1, SSD1306_BLACK);
+          display.drawLine(screenX, screenY, screenX + 2, screenY + 1, SSD1306_BLACK);
+          break;
+        case 2:
+          display.fillCircle(screenX, screenY - 1, 3, SSD1306_WHITE);
+          display.fillRect(screenX - 3, screenY, 6, 3, SSD1306_WHITE);
+          display.drawPixel(screenX - 2, screenY + 3, SSD1306_WHITE);
+          display.drawPixel(screenX, screenY + 2, SSD1306_WHITE);
+          display.drawPixel(screenX + 2, screenY + 3, SSD1306_WHITE);
+          display.drawPixel(screenX - 1, screenY - 2, SSD1306_BLACK);
+          display.drawPixel(screenX + 1, screenY - 2, SSD1306_BLACK);
+          break;
+        case 3:
+          display.fillRect(screenX - 4, screenY - 4, 8, 6, SSD1306_WHITE);
+          display.drawPixel(screenX - 2, screenY - 2, SSD1306_BLACK);
+          display.drawPixel(screenX + 2, screenY - 2, SSD1306_BLACK);
+          break;
+      }
+    }
+  }
+}
+
+static void actorSpritesWorkload() {
+  for (int y = 0; y < MAZE_HEIGHT; y++) {
+    for (int x = 0; x < MAZE_WIDTH; x++) {
+      int screenX = x * CELL_SIZE + CELL_SIZE/2;
+      int screenY = y * CELL_SIZE + CELL_SIZE/2;
+      
+      switch ((x + y) % 4) {
+        case 0:
+          display.drawSprite(spriteDot, screenX, screenY);
+          break;
+        case 1:
+          display.drawSprite(spritePacman[0], screenX, screenY);
+          break;
+        case 2:
+          display.drawSprite(spriteGhost, screenX, screenY);
+          break;
+        case 3:
+          display.drawSprite(spriteCar, screenX - 4, screenY - 4);
+          break;
+      }
+    }
+  }
+}
+
+// HUD numbers of every game on one screen, and the game over screen laid
+// out with getTextBounds on every call as it used to be
+
+static void hudWorkload() {
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  for (int row = 0; row < DISPLAY_PAGES; row++) {
+    display.setCursor(0, row * TEXT_CHAR_HEIGHT);
+    display.printNumber(row * 1234L);
+    display.setCursor(SCREEN_WIDTH / 2, row * TEXT_CHAR_HEIGHT);
+    display.printNumber(-row * 97L);
+  }
+}
+
+static const char* const endScreenLines[] = {"GAME OVER", "NEW HIGHSCORE!", "UP: Menu", "RIGHT: Restart"};
+static CenteredText endScreenLayout[] = {
+  {"GAME OVER", 2}, {"NEW HIGHSCORE!", 1}, {"UP: Menu", 1}, {"RIGHT: Restart", 1}
+};
+
+static void boundsTextWorkload() {
+  for (uint8_t i = 0; i < 4; i++) {
+    uint8_t textSize = (i == 0) ? 2 : 1;
+    int16_t x1, y1;
+    uint16_t w, h;
+    display.setTextSize(textSize);
+    display.setTextColor(SSD1306_WHITE);
+    display.getTextBounds(endScreenLines[i], 0, 0, &x1, &y1, &w, &h);
+    display.setCursor((SCREEN_WIDTH - w) / 2, i * 16);
+    display.print(endScreenLines[i]);
+  }
+}
+
+static void cachedTextWorkload() {
+  for (uint8_t i = 0; i < 4; i++) {
+    drawCenteredText(endScreenLayout[i], i * 16);
+  }
+}
+
+// Intro and menu art, streamed from the packed assets and drawn with
+// drawBitmap() from the raw arrays they were converted from
+
+static const Asset* const packedAssets[] = {&assetIntro, &assetGameHeader, &assetSelect};
+static uint8_t* rawAssets[3];
+
+static uint8_t* unpackAsset(const Asset& asset) {
+  // Back to drawBitmap() layout: rows of bytes, most significant bit first
+  uint16_t stride = (asset.width + 7) / 8;
+  uint8_t* raw = (uint8_t*)calloc(stride * asset.height, 1);
+  if (!raw) return NULL;
+  
+  AssetStream stream(asset);
+  for (uint8_t top = 0; top < asset.height; top += 8) {
+    for (uint8_t x = 0; x < asset.width; x++) {
+      uint8_t bits = stream.next();
+      for (uint8_t row = 0; row < 8 && top + row < asset.height; row++) {
+        if (bits & (1 << row)) raw[(top + row) * stride + x / 8] |= 0x80 >> (x % 8);
+      }
+    }
+  }
+  return raw;
+}
+
+static void rawAssetsWorkload() {
+  for (uint8_t i = 0; i < 3; i++) {
+    const Asset& asset = *packedAssets[i];
+    display.drawBitmap(0, i * 23, rawAssets[i], asset.width, asset.height, SSD1306_WHITE);
+  }
+}
+
+static void packedAssetsWorkload() {
+  for (uint8_t i = 0; i < 3; i++) {
+    display.drawAsset(*packedAssets[i], 0, i * 23);
+  }
+}
+
+static uint32_t bufferChecksum() {
+  const uint8_t* buffer = display.getBuffer();
+  uint32_t checksum = 2166136261UL;
+  for (int i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+    checksum = (checksum ^ buffer[i]) * 16777619UL;
+  }
+  return checksum;
+}
+
+static unsigned long timeWorkload(Workload draw) {
+  unsigned long start = micros();
+  for (int i = 0; i < BENCHMARK_ROUNDS; i++) {
+    display.clearDisplay();
+    draw();
+  }
+  return (micros() - start) / BENCHMARK_ROUNDS;
+}
+
+static void benchmarkRaster() {
+#if DISPLAY_PAGED
+  Serial.println(F("Raster: not available in paged mode"));
+#else
+  Serial.println(F("Raster fills, us per frame (GFX / kernels)"));
+  
+  for (uint8_t i = 0; i < sizeof(rasterWorkloads) / sizeof(rasterWorkloads[0]); i++) {
+    display.setRasterKernels(false);
+    unsigned long generic = timeWorkload(rasterWorkloads[i].draw);
+    uint32_t expected = bufferChecksum();
+    
+    display.setRasterKernels(true);
+    unsigned long kernels = timeWorkload(rasterWorkloads[i].draw);
+    
+    Serial.print(rasterWorkloads[i].name);
+    Serial.print(F(": "));
+    Serial.print(generic);
+    Serial.print(F(" / "));
+    Serial.print(kernels);
+    if (bufferChecksum() != expected) Serial.print(F(" MISMATCH"));
+    Serial.println();
+  }
+  
+  display.clearDisplay();
+#endif
+}
+
+static void benchmarkSprites() {
+#if DISPLAY_PAGED
+  Serial.println(F("Sprites: not available in paged mode"));
+#else
+  unsigned long primitives = timeWorkload(actorPrimitivesWorkload);
+  uint32_t expected = bufferChecksum();
+  unsigned long sprites = timeWorkload(actorSpritesWorkload);
+  
+  Serial.print(F("Sprites, us per frame (primitives / atlas): "));
+  Serial.print(primitives);
+  Serial.print(F(" / "));
+  Serial.print(sprites);
+  if (bufferChecksum() != expected) Serial.print(F(" MISMATCH"));
+  Serial.println();
+  
+  display.clearDisplay();
+#endif
+}
+
+static void benchmarkText() {
+#if DISPLAY_PAGED
+  Serial.println(F("Text: not available in paged mode"));
+#else
+  display.setRasterKernels(false);
+  unsigned long printed = timeWorkload(hudWorkload);
+  uint32_t expected = bufferChecksum();
+  display.setRasterKernels(true);
+  unsigned long blitted = timeWorkload(hudWorkload);
+  
+  Serial.print(F("Numbers, us per frame (print / glyph cache): "));
+  Serial.print(printed);
+  Serial.print(F(" / "));
+  Serial.print(blitted);
+  if (bufferChecksum() != expected) Serial.print(F(" MISMATCH"));
+  Serial.println();
+  
+  unsigned long bounds = timeWorkload(boundsTextWorkload);
+  expected = bufferChecksum();
+  unsigned long cached = timeWorkload(cachedTextWorkload);
+  
+  Serial.print(F("Centered text, us per frame (getTextBounds / cached): "));
+  Serial.print(bounds);
+  Serial.print(F(" / "));
+  Serial.print(cached);
+  if (bufferChecksum() != expected) Serial.print(F(" MISMATCH"));
+  Serial.println();
+  
+  display.clearDisplay();
+#endif
+}
+
+static void benchmarkAssets() {
+#if DISPLAY_PAGED
+  Serial.println(F("Assets: not available in paged mode"));
+#else
+  for (uint8_t i = 0; i < 3; i++) {
+    rawAssets[i] = unpackAsset(*packedAssets[i]);
+  }
+  
+  if (rawAssets[0] && rawAssets[1] && rawAssets[2]) {
+    unsigned long raw = timeWorkload(rawAssetsWorkload);
+    uint32_t expected = bufferChecksum();
+    unsigned long packed = timeWorkload(packedAssetsWorkload);
+    
+    Serial.print(F("Assets, us per frame (drawBitmap / packed): "));
+    Serial.print(raw);
+    Serial.print(F(" / "));
+    Serial.print(packed);
+    if (bufferChecksum() != expected) Serial.print(F(" MISMATCH"));
+    Serial.println();
+  } else {
+    Serial.println(F("Assets: out of memory"));
+  }
+  
+  for (uint8_t i = 0; i < 3; i++) {
+    free(rawAssets[i]);
+    rawAssets[i] = NULL;
+  }
+  display.clearDisplay();
+#endif
+}
+
+static void benchmarkInput() {
+  static const uint8_t pins[BUTTON_COUNT] = {
+    PIN_BUTTON_UP, PIN_BUTTON_DOWN, PIN_BUTTON_LEFT, PIN_BUTTON_RIGHT
+  };
+  
+  // Pin by pin with a bool per button, as updateInput() used to poll
+  bool levels[BUTTON_COUNT] = {false, false, false, false};
+  uint8_t edges = 0;
+  unsigned long start = micros();
+  for (int i = 0; i < INPUT_SAMPLE_ROUNDS; i++) {
+    for (uint8_t b = 0; b < BUTTON_COUNT; b++) {
+      bool level = (digitalRead(pins[b]) == LOW);
+      if (level && !levels[b]) edges++;
+      levels[b] = level;
+    }
+  }
+  unsigned long pinned = micros() - start;
+  
+  // One read into a mask, edges for all buttons at once
+  uint8_t previous = 0;
+  uint8_t maskEdges = 0;
+  start = micros();
+  for (int i = 0; i < INPUT_SAMPLE_ROUNDS; i++) {
+    uint8_t current = sampleButtons();
+    maskEdges += __builtin_popcount(current & ~previous);
+    previous = current;
+  }
+  unsigned long sampled = micros() - start;
+  
+  Serial.print(F("Input, ns per sample (digitalRead / mask): "));
+  Serial.print(pinned * 1000UL / INPUT_SAMPLE_ROUNDS);
+  Serial.print(F(" / "));
+  Serial.print(sampled * 1000UL / INPUT_SAMPLE_ROUNDS);
+  if (edges != maskEdges) Serial.print(F(" MISMATCH"));
+  Serial.println();
+}
+
+static void benchmarkPhysics() {
+  // A ball falling onto the floor and bouncing, stepped with floats as the
+  // games used to. 0.25 and the bounce are exact in both, so both paths
+  // must land on the same pixel.
+  float y = 0;
+  float velY = 0;
+  unsigned long start = micros();
+  for (long i = 0; i < PHYSICS_STEPS; i++) {
+    velY += 0.25f;
+    y += velY;
+    if (y > SCREEN_HEIGHT - 4) {
+      y = SCREEN_HEIGHT - 4;
+      velY = -velY;
+    }
+  }
+  unsigned long floated = micros() - start;
+  
+  Body body;
+  body.place(0, 0);
+  body.velX = 0;
+  body.velY = 0;
+  const Fixed gravity = Fixed::fromFloat(0.25);
+  start = micros();
+  for (long i = 0; i < PHYSICS_STEPS; i++) {
+    body.step(0, gravity);
+    if (body.y > SCREEN_HEIGHT - 4) {
+      body.y = SCREEN_HEIGHT - 4;
+      body.velY = -body.velY;
+    }
+  }
+  unsigned long fixed = micros() - start;
+  
+  Serial.print(F("Physics, ns per step (float / fixed): "));
+  Serial.print(floated * 1000UL / PHYSICS_STEPS);
+  Serial.print(F(" / "));
+  Serial.print(fixed * 1000UL / PHYSICS_STEPS);
+  if ((int)y != body.y.toInt()) Serial.print(F(" MISMATCH"));
+  Serial.println();
+}
+
+// The per-frame calls as GameManager made them before the registry, a
+// switch over the games with the members inlined
+static unsigned long switchDispatch(int gameId, void* data) {
+  switch (gameId) {
+    case GAME_SNAKE: {
+      SnakeGame* game = static_cast<SnakeGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_TETRIS: {
+      TetrisGame* game = static_cast<TetrisGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_FLAPPY: {
+      FlappyGame* game = static_cast<FlappyGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_2048: {
+      Game2048* game = static_cast<Game2048*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_BREAKOUT: {
+      BreakoutGame* game = static_cast<BreakoutGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_FROGGER: {
+      FroggerGame* game = static_cast<FroggerGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_HELICOPTER: {
+      HelicopterGame* game = static_cast<HelicopterGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+    case GAME_PACMAN: {
+      PacManGame* game = static_cast<PacManGame*>(data);
+      return game->getFrameVersion() + game->isGameOver() + game->isGameWon();
+    }
+  }
+  return 0;
+}
+
+static unsigned long registryDispatch(const GameEntry* game, void* data) {
+  return game->getFrameVersion(data) + game->isGameOver(data) + game->isGameWon(data);
+}
+
+static void benchmarkDispatch() {
+  Serial.println(F("Game dispatch, ns per frame (switch / registry)"));
+  for (int i = 0; i < GameRegistry::count; i++) {
+    const GameEntry& entry = GameRegistry::games[i];
+    gameArena.start(entry);
+    void* data = gameArena.getData();
+    
+    // Read back every round, so the dispatch cannot move out of the loop
+    volatile int selectedId = entry.id;
+    const GameEntry* volatile selectedEntry = &entry;
+    
+    unsigned long switchSum = 0;
+    unsigned long start = micros();
+    for (long r = 0; r < DISPATCH_ROUNDS; r++) switchSum += switchDispatch(selectedId, data);
+    unsigned long switched = micros() - start;
+    
+    unsigned long registrySum = 0;
+    start = micros();
+    for (long r = 0; r < DISPATCH_ROUNDS; r++) registrySum += registryDispatch(selectedEntry, data);
+    unsigned long registered = micros() - start;
+    
+    Serial.print(entry.name);
+    Serial.print(F(": "));
+    Serial.print(switched * 1000UL / DISPATCH_ROUNDS);
+    Serial.print(F(" / "));
+    Serial.print(registered * 1000UL / DISPATCH_ROUNDS);
+    if (switchSum != registrySum) Serial.print(F(" MISMATCH"));
+    Serial.println();
+  }
+  gameArena.stop();
+}
+
+void runBenchmarks() {
+  Serial.println(F("--- Benchmarks ---"));
+  benchmarkRaster();
+  benchmarkSprites();
+  benchmarkText();
+  benchmarkAssets();
+  benchmarkInput();
+  benchmarkPhysics();
+  benchmarkDispatch();
+}
+#endif
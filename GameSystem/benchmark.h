@@ -0,0 +1,11 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "config.h"
+
+#if ENABLE_BENCHMARKS
+// Times the drawing paths against each other and prints the results
+void runBenchmarks();
+#endif
+
+#endif
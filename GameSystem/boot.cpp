@@ -0,0 +1,71 @@
+#include "boot.h"
+#include "input.h"
+#include "frameclock.h"
+#include "logger.h"
+
+BootSequence bootSequence;
+
+static const char* const stageNames[BOOT_STAGES] = {
+  "reset", "display", "benchmarks", "intro", "input", "highscores", "wait", "menu"
+};
+
+void BootSequence::begin() {
+  // micros() counts from reset, so the time before setup() is the first stage
+  for (uint8_t i = 0; i < BOOT_STAGES; i++) stageMicros[i] = 0;
+  stageStart = 0;
+  skipped = false;
+  done = false;
+  endStage(BOOT_RESET);
+}
+
+void BootSequence::endStage(BootStage stage) {
+  unsigned long now = micros();
+  stageMicros[stage] += now - stageStart;
+  stageStart = now;
+  
+  // The intro's time counts from when it is on screen
+  if (stage == BOOT_INTRO) introStart = frameClock.wallMicros();
+}
+
+bool BootSequence::introOver() {
+  if (sampleButtons() != 0) {
+    skipped = true;
+  } else if (frameClock.wallMicros() - introStart < INTRO_MS * 1000UL) {
+    // Idle time, print what the boot stages logged
+    drainLog();
+    frameClock.sleep(BOOT_POLL_MS);
+    return false;
+  }
+  
+  // The button that skipped is not a press in the menu
+  discardInput();
+  endStage(BOOT_WAIT);
+  return true;
+}
+
+void BootSequence::finish() {
+  endStage(BOOT_MENU);
+  done = true;
+#if REPORT_BOOT_TIME
+  printStats();
+#endif
+}
+
+unsigned long BootSequence::getTotalMicros() {
+  unsigned long total = 0;
+  for (uint8_t i = 0; i < BOOT_STAGES; i++) total += stageMicros[i];
+  return total;
+}
+
+void BootSequence::printStats() {
+  Serial.print(F("Boot:"));
+  for (uint8_t i = 0; i < BOOT_STAGES; i++) {
+    Serial.print(' ');
+    Serial.print(stageNames[i]);
+    Serial.print(' ');
+    Serial.print(stageMicros[i] / 1000);
+  }
+  Serial.print(F(" ms, menu after "));
+  Serial.print(getTotalMicros() / 1000);
+  Serial.println(skipped ? F(" ms (intro skipped)") : F(" ms"));
+}
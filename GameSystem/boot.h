@@ -0,0 +1,47 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+#include "config.h"
+
+#define BOOT_POLL_MS 10  // How often the intro looks at the buttons
+
+// Boot stages in the order they run
+enum BootStage {
+  BOOT_RESET,       // Reset to setup(), bootloader and runtime start
+  BOOT_DISPLAY,
+  BOOT_BENCHMARKS,
+  BOOT_INTRO,       // Drawing and flushing the intro
+  BOOT_INPUT,       // Buttons and the replay seed
+  BOOT_HIGHSCORES,
+  BOOT_WAIT,        // Rest of the intro, until INTRO_MS is over or a button
+  BOOT_MENU,
+  BOOT_STAGES
+};
+
+// Brings the system up in stages. setup() draws the intro as soon as the
+// display is up and loads the rest behind it; loop() then waits out what is
+// left of INTRO_MS, or less when a button is pressed, and starts the menu.
+// The time of every stage is kept, so cold boot to menu can be reported.
+class BootSequence {
+private:
+  unsigned long stageMicros[BOOT_STAGES];
+  unsigned long stageStart;  // micros() the current stage began
+  unsigned long introStart;  // Wall time the intro was shown
+  bool skipped;              // A button cut the intro short
+  bool done;
+  
+public:
+  BootSequence() : stageStart(0), introStart(0), skipped(false), done(false) {}
+  void begin();
+  void endStage(BootStage stage);
+  bool introOver();
+  void finish();
+  bool isDone() { return done; }
+  unsigned long getStageMicros(BootStage stage) { return stageMicros[stage]; }
+  unsigned long getTotalMicros();
+  void printStats();
+};
+
+extern BootSequence bootSequence;
+
+#endif
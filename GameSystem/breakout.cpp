@@ -1,8 +1,29 @@
 #include "breakout.h"
 #include "display.h"
 #include "input.h"
+#include "frameclock.h"
+#include "replay.h"
+#include "text.h"
 
-BreakoutGame breakoutGame;
+static CenteredText winText = {"YOU WIN!", 1};
+
+// Launch velocity at 2 pixels per step for 0 to 45 degrees off vertical,
+// sin and cos as raw Fixed so serving the ball runs no float math
+#define LAUNCH_ANGLES 46
+static constexpr int32_t launchVectors[LAUNCH_ANGLES][2] = {
+  {0, 131072}, {2288, 131052}, {4574, 130992}, {6860, 130892},
+  {9143, 130753}, {11424, 130573}, {13701, 130354}, {15974, 130095},
+  {18242, 129796}, {20504, 129458}, {22760, 129081}, {25010, 128664},
+  {27251, 128208}, {29485, 127713}, {31709, 127179}, {33924, 126606},
+  {36128, 125994}, {38322, 125345}, {40503, 124657}, {42673, 123931},
+  {44829, 123167}, {46972, 122366}, {49100, 121528}, {51214, 120652},
+  {53312, 119740}, {55393, 118792}, {57458, 117807}, {59505, 116786},
+  {61535, 115730}, {63545, 114638}, {65536, 113512}, {67507, 112351},
+  {69458, 111155}, {71387, 109926}, {73295, 108664}, {75180, 107368},
+  {77042, 106039}, {78881, 104679}, {80696, 103286}, {82486, 101862},
+  {84251, 100407}, {85991, 98921}, {87704, 97405}, {89391, 95860},
+  {91050, 94285}, {92682, 92682}
+};
 
 void BreakoutGame::init() {
   // Initialize paddle
@@ -18,20 +39,28 @@ void BreakoutGame::init() {
   score = 0;
   lives = 3;
   gameOver = false;
+  frameVersion = 0;
   gameWon = false;
-  lastUpdate = millis();
+  physics.begin(PHYSICS_STEP_MS, frameClock.now());
   
   resetBall();
 }
 
 void BreakoutGame::update() {
-  unsigned long currentTime = millis();
-  float deltaTime = (currentTime - lastUpdate) / 16.0;
-  lastUpdate = currentTime;
-  
   if (gameOver || gameWon) return;
   
-  handleInput(); // NOW called in update!
+  // The ball is drawn ahead between steps, so every update changes the frame
+  frameVersion++;
+  
+  uint8_t steps = physics.advance(frameClock.now());
+  for (uint8_t i = 0; i < steps && !gameOver; i++) {
+    step();
+  }
+}
+
+void BreakoutGame::step() {
+  // Held buttons move the paddle by the step, not by the update
+  handleInput();
   updatePaddle();
   updateBall();
   
@@ -56,7 +85,7 @@ void BreakoutGame::draw() {
   drawUI();
   
   if (gameWon) {
-    drawCenteredText("YOU WIN!", 30, 1);
+    drawCenteredText(winText, 30);
   }
   
   updateDisplay();
@@ -73,23 +102,23 @@ void BreakoutGame::handleInput() {
 }
 
 void BreakoutGame::resetBall() {
-  ball.x = SCREEN_WIDTH / 2;
-  ball.y = PADDLE_Y - 10;
+  ball.place(SCREEN_WIDTH / 2, PADDLE_Y - 10);
   
-  // Random angle upward
-  float angle = random(-45, 46) * PI / 180.0;
-  ball.velX = sin(angle) * 2.0;
-  ball.velY = -abs(cos(angle)) * 2.0; // Always upward
+  // Random angle upward, the table holds one side of the vertical
+  int angle = gameRandom(-(LAUNCH_ANGLES - 1), LAUNCH_ANGLES);
+  const int32_t* launch = launchVectors[abs(angle)];
+  ball.velX = Fixed::fromRaw(angle < 0 ? -launch[0] : launch[0]);
+  ball.velY = -Fixed::fromRaw(launch[1]); // Always upward
 }
 
 void BreakoutGame::updateBall() {
-  ball.x += ball.velX;
-  ball.y += ball.velY;
+  ball.step(0, 0);
   
   // Wall collisions (left/right)
   if (ball.x <= 0 || ball.x >= SCREEN_WIDTH - BALL_SIZE) {
     ball.velX = -ball.velX;
-    ball.x = constrain(ball.x, 0, SCREEN_WIDTH - BALL_SIZE);
+    if (ball.x < 0) ball.x = 0;
+    if (ball.x > SCREEN_WIDTH - BALL_SIZE) ball.x = SCREEN_WIDTH - BALL_SIZE;
   }
   
   // Top wall collision
@@ -109,14 +138,15 @@ void BreakoutGame::updateBall() {
   
   // Paddle collision
   if (checkBallPaddleCollision()) {
-    ball.velY = -abs(ball.velY); // Always bounce upward
+    ball.velY = -ball.velY.absolute(); // Always bounce upward
     
     // Add horizontal velocity based on where ball hits paddle
-    float hitPos = (ball.x + BALL_SIZE/2 - paddle.x) / PADDLE_WIDTH;
-    ball.velX = (hitPos - 0.5) * 3.0;
+    Fixed hitPos = (ball.x + BALL_SIZE/2 - paddle.x) / PADDLE_WIDTH;
+    ball.velX = (hitPos - Fixed::fromFloat(0.5)) * 3;
     
     // Limit maximum speed
-    if (abs(ball.velX) > 2.5) ball.velX = (ball.velX > 0) ? 2.5 : -2.5;
+    const Fixed maxSpeed = Fixed::fromFloat(2.5);
+    if (ball.velX.absolute() > maxSpeed) ball.velX = (ball.velX > 0) ? maxSpeed : -maxSpeed;
   }
   
   // Brick collision
@@ -136,9 +166,6 @@ bool BreakoutGame::checkBallPaddleCollision() {
 }
 
 bool BreakoutGame::checkBallBrickCollision() {
-  int ballCenterX = ball.x + BALL_SIZE / 2;
-  int ballCenterY = ball.y + BALL_SIZE / 2;
-  
   for (int row = 0; row < BRICK_ROWS; row++) {
     for (int col = 0; col < BRICK_COLS; col++) {
       if (!bricks[row][col]) continue;
@@ -157,16 +184,16 @@ bool BreakoutGame::checkBallBrickCollision() {
         score += (BRICK_ROWS - row) * 10; // Higher rows worth more points
         
         // Determine bounce direction
-        float ballCenterX = ball.x + BALL_SIZE / 2;
-        float ballCenterY = ball.y + BALL_SIZE / 2;
-        float brickCenterX = brickX + BRICK_WIDTH / 2;
-        float brickCenterY = brickY + BRICK_HEIGHT / 2;
+        Fixed ballCenterX = ball.x + BALL_SIZE / 2;
+        Fixed ballCenterY = ball.y + BALL_SIZE / 2;
+        int brickCenterX = brickX + BRICK_WIDTH / 2;
+        int brickCenterY = brickY + BRICK_HEIGHT / 2;
         
-        float deltaX = ballCenterX - brickCenterX;
-        float deltaY = ballCenterY - brickCenterY;
+        Fixed deltaX = ballCenterX - brickCenterX;
+        Fixed deltaY = ballCenterY - brickCenterY;
         
         // Bounce based on which side was hit
-        if (abs(deltaX) > abs(deltaY)) {
+        if (deltaX.absolute() > deltaY.absolute()) {
           ball.velX = -ball.velX; // Side collision
         } else {
           ball.velY = -ball.velY; // Top/bottom collision
@@ -181,7 +208,8 @@ bool BreakoutGame::checkBallBrickCollision() {
 }
 
 void BreakoutGame::drawBall() {
-  display.fillRect(ball.x, ball.y, BALL_SIZE, BALL_SIZE, SSD1306_WHITE);
+  Fixed alpha = physics.alpha();
+  display.fillRect(ball.drawX(alpha), ball.drawY(alpha), BALL_SIZE, BALL_SIZE, SSD1306_WHITE);
 }
 
 void BreakoutGame::drawPaddle() {
@@ -208,12 +236,12 @@ void BreakoutGame::drawUI() {
   // Score
   display.setCursor(0, 0);
   display.print(F("Score:"));
-  display.print(score);
+  display.printNumber(score);
   
   // Lives
   display.setCursor(SCREEN_WIDTH - 45, 0);
   display.print(F("Lives:"));
-  display.print(lives);
+  display.printNumber(lives);
 }
 
 int BreakoutGame::countRemainingBricks() {
@@ -224,4 +252,15 @@ int BreakoutGame::countRemainingBricks() {
     }
   }
   return count;
-}
\ No newline at end of file
+}
+
+void BreakoutGame::serialize(SaveStream& state) {
+  ball.serialize(state);
+  state.value(paddle.x);
+  state.bytes(bricks, sizeof(bricks));
+  state.value(score);
+  state.value(lives);
+  state.value(gameOver);
+  state.value(gameWon);
+  physics.serialize(state);
+}
@@ -2,6 +2,7 @@
 #define BREAKOUT_H
 
 #include "config.h"
+#include "physics.h"
 
 #define PADDLE_WIDTH 16
 #define PADDLE_HEIGHT 3
@@ -13,26 +14,23 @@
 #define BRICK_COLS 10
 #define BRICK_OFFSET_Y 10
 
-struct Ball {
-  float x, y;
-  float velX, velY;
-};
-
 struct Paddle {
   int x;
 };
 
 class BreakoutGame {
 private:
-  Ball ball;
+  Body ball;
   Paddle paddle;
   bool bricks[BRICK_ROWS][BRICK_COLS];
   int score;
   int lives;
   bool gameOver;
+  unsigned long frameVersion;
   bool gameWon;
-  unsigned long lastUpdate;
+  PhysicsClock physics;
   
+  void step();
   void resetBall();
   void updateBall();
   void updatePaddle();
@@ -49,12 +47,13 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  unsigned long getFrameVersion() { return frameVersion; }
   bool isGameWon() { return gameWon; }
   int getScore() { return score; }
   const char* getName() { return "BREAKOUT"; }
+  const Body& getBall() { return ball; }
 };
 
-extern BreakoutGame breakoutGame;
-
 #endif
\ No newline at end of file
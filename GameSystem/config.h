@@ -14,6 +14,8 @@
 #define PIN_BUTTON_DOWN 5
 #define PIN_BUTTON_LEFT 15
 #define PIN_BUTTON_RIGHT 18
+#define USE_INPUT_INTERRUPTS 1 // Buttons queue their edges from GPIO interrupts
+#define INPUT_QUEUE_SIZE 32    // Button edges buffered between updates, power of two
 
 // Display Pins
 #define PIN_SCL 22
@@ -24,12 +26,50 @@
 #define SCREEN_HEIGHT 64
 #define OLED_RESET -1
 #define SCREEN_ADDRESS 0x3C
+#define DISPLAY_PIPELINE 1    // Flush frames from a task on the other core
+#define DISPLAY_FLUSH_CORE 0
+#ifndef DISPLAY_PAGED         // The host tests also build a paged variant with -D
+#define DISPLAY_PAGED 0       // Record draw calls, rasterize page by page
+#define DISPLAY_PAGED_VERIFY 0 // Keep the framebuffer and compare pages
+#define DISPLAY_LIST_SIZE 768 // Bytes of recorded draw calls per frame
+#endif
+#define USE_SCROLL_LAYER 1    // Side-scrollers redraw only exposed columns
+#define USE_BACKGROUND_CACHE 1 // Frames start from a copy of the static background
 
 // Game Constants
 #define MAX_GAMES 8
-#define BUTTON_DELAY 150
+#define GAME_TICK_MS 16        // Game logic step, about 60 ticks per second
+#define MAX_CATCHUP_TICKS 4    // Ticks run back to back after a slow frame, the rest is dropped
+#define PHYSICS_STEP_MS 16     // Step of the moving bodies in Flappy and Breakout
+#define BUTTON_DELAY 150       // Hold time before a button starts repeating (ms)
+#define BUTTON_REPEAT_RATE 50  // Time between repeats while held (ms)
+#define BUTTON_DEBOUNCE 5      // Edges closer than this after an accepted one are bounce (ms)
+#define SKIP_UNCHANGED_FRAMES 1 // Skip draw and flush when a game reports no change
+#define INTRO_MS 12000         // Intro screen at boot, any button skips it
 
-// Game IDs
+// Diagnostics
+#define ENABLE_BENCHMARKS 0   // Time drawing kernels over Serial at boot
+#define TRACK_INPUT_LATENCY 1 // Press-to-flush histogram per game, printed at game over
+#define RECORD_INPUT 0        // Record every frame's input for replay, dumped at game over
+#define REPLAY_BUFFER_SIZE 4096 // Bytes of recorded input kept in RAM
+#define HEADLESS 0            // Game logic only: no drawing or flushing, virtual clock
+#define ENABLE_PROFILER 0     // Time input, update, draw and flush per game, dumped at game over
+#define LOG_LEVEL 3           // 0 off, 1 errors, 2 warnings, 3 info, 4 debug; higher levels compile out
+#define LOG_BUFFER_SIZE 512   // Bytes of log entries waiting for idle time
+#define REPORT_GAME_FOOTPRINT 0 // Name each game's RAM size in a compiler warning
+#define REPORT_BOOT_TIME 1    // Print each boot stage's time once the menu is up
+
+// Games in the menu, 0 leaves a game out of the build
+#define ENABLE_GAME_SNAKE 1
+#define ENABLE_GAME_TETRIS 1
+#define ENABLE_GAME_FLAPPY 1
+#define ENABLE_GAME_2048 1
+#define ENABLE_GAME_BREAKOUT 1
+#define ENABLE_GAME_FROGGER 1
+#define ENABLE_GAME_HELICOPTER 1
+#define ENABLE_GAME_PACMAN 1
+
+// Game IDs, also the highscore slots, so they stay fixed when games are left out
 enum GameID {
   GAME_SNAKE = 0,
   GAME_TETRIS = 1,
@@ -46,10 +86,12 @@ enum GameState {
   STATE_MENU,
   STATE_PLAYING,
   STATE_GAME_OVER,
-  STATE_GAME_WON
+  STATE_GAME_WON,
+  STATE_PAUSED
 };
 
-// Global display object
-extern Adafruit_SSD1306 display;
+// Global display object (defined in display.h)
+class GameDisplay;
+extern GameDisplay display;
 
 #endif
\ No newline at end of file
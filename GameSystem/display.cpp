@@ -1,6 +1,560 @@
 #include "display.h"
+#include "framepipeline.h"
+#include "latency.h"
+#include "raster.h"
+#include "text.h"
+#include "profiler.h"
 
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+GameDisplay display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+
+GameDisplay::GameDisplay(uint8_t w, uint8_t h, TwoWire *twi, int8_t resetPin)
+  : Adafruit_SSD1306(w, h, twi, resetPin) {
+  panelValid = false;
+#if !DISPLAY_PAGED
+  rasterKernels = true;
+#else
+  recording = false;
+  rasterizing = false;
+  pagePass = false;
+  recordDepth = 0;
+  verifyMismatches = 0;
+  pagePasses = 0;
+#endif
+  resetFlushStats();
+}
+
+bool GameDisplay::begin(uint8_t switchvcc, uint8_t i2caddr) {
+  // Panel RAM content is unknown after reset, first flush sends everything
+  panelValid = false;
+  if (!Adafruit_SSD1306::begin(switchvcc, i2caddr)) return false;
+  
+#if DISPLAY_PAGED
+#if !DISPLAY_PAGED_VERIFY
+  // Only pageBuffer is needed from here on
+  free(buffer);
+  buffer = NULL;
+#endif
+  displayList.clear();
+  recording = true;
+#endif
+  return true;
+}
+
+void GameDisplay::displayChanges() {
+#if DISPLAY_PAGED
+  displayPages();
+#else
+  displayChanges(buffer);
+#endif
+}
+
+#if !DISPLAY_PAGED
+void GameDisplay::displayChanges(const uint8_t* frame) {
+  lastFlushBytes = 0;
+  wire->setClock(wireClk);
+  
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    const uint8_t* row = frame + page * SCREEN_WIDTH;
+    uint8_t* shown = panel + page * SCREEN_WIDTH;
+    
+    int first = 0;
+    int last = SCREEN_WIDTH - 1;
+    
+    if (panelValid) {
+      // Find the changed column range within this page
+      while (first < SCREEN_WIDTH && row[first] == shown[first]) first++;
+      if (first == SCREEN_WIDTH) continue;
+      while (row[last] == shown[last]) last--;
+    }
+    
+    memcpy(shown + first, row + first, last - first + 1);
+    sendWindow(page, first, last, row + first);
+  }
+  
+  wire->setClock(restoreClk);
+  panelValid = true;
+  totalFlushBytes += lastFlushBytes;
+  flushCount++;
+}
+#endif
+
+void GameDisplay::sendWindow(uint8_t page, uint8_t firstColumn, uint8_t lastColumn, const uint8_t* data) {
+  // Restrict the write window to one page and the changed columns
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  wire->write((uint8_t)SSD1306_PAGEADDR);
+  wire->write(page);
+  wire->write(page);
+  wire->write((uint8_t)SSD1306_COLUMNADDR);
+  wire->write(firstColumn);
+  wire->write(lastColumn);
+  wire->endTransmission();
+  lastFlushBytes += 7;
+  
+  uint16_t count = lastColumn - firstColumn + 1;
+  
+  while (count > 0) {
+    uint16_t chunk = min(count, (uint16_t)(DISPLAY_I2C_CHUNK - 1));
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x40);
+    wire->write(data, chunk);
+    wire->endTransmission();
+    
+    lastFlushBytes += chunk + 1;
+    data += chunk;
+    count -= chunk;
+  }
+}
+
+void GameDisplay::drawSprite(const Sprite& sprite, int16_t x, int16_t y) {
+#if DISPLAY_PAGED
+  if (rasterizing) {
+    uint8_t page = rasterTop >> 3;
+    rasterSprite(pageBuffer, page, page, x, y, sprite);
+    return;
+  }
+  
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addSprite(x, y, sprite)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  drawSpritePixels(sprite, x, y);
+  recordDepth = depth;
+#else
+  if (!rasterKernels || !buffer || rotation) {
+    drawSpritePixels(sprite, x, y);
+    return;
+  }
+  rasterSprite(buffer, 0, DISPLAY_PAGES - 1, x, y, sprite);
+#endif
+}
+
+void GameDisplay::drawAsset(const Asset& asset, int16_t x, int16_t y) {
+#if DISPLAY_PAGED
+  if (rasterizing) {
+    uint8_t page = rasterTop >> 3;
+    rasterAsset(pageBuffer, page, page, x, y, asset);
+    return;
+  }
+  
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addAsset(x, y, asset)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  drawAssetPixels(asset, x, y);
+  recordDepth = depth;
+#else
+  if (!rasterKernels || !buffer || rotation) {
+    drawAssetPixels(asset, x, y);
+    return;
+  }
+  rasterAsset(buffer, 0, DISPLAY_PAGES - 1, x, y, asset);
+#endif
+}
+
+void GameDisplay::drawAssetPixels(const Asset& asset, int16_t x, int16_t y) {
+  AssetStream stream(asset);
+  
+  for (uint8_t top = 0; top < asset.height; top += 8) {
+    for (uint8_t i = 0; i < asset.width; i++) {
+      uint8_t bits = stream.next();
+      for (uint8_t row = 0; row < 8; row++) {
+        if (bits & (1 << row)) drawPixel(x + i, y + top + row, SSD1306_WHITE);
+      }
+    }
+  }
+}
+
+void GameDisplay::printNumber(long value) {
+#if !DISPLAY_PAGED
+  // Same output and cursor movement as print(value), with the digits
+  // blitted from the glyph cache instead of drawn pixel by pixel
+  if (rasterKernels && buffer && !rotation && !gfxFont && textsize_x == 1 &&
+      textsize_y == 1 && textcolor == textbgcolor && digitGlyph('0')) {
+    char digits[11];
+    uint8_t count = 0;
+    unsigned long magnitude = (value < 0) ? 0UL - (unsigned long)value : value;
+    do {
+      digits[count++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[count++] = '-';
+    
+    while (count > 0) {
+      if (wrap && cursor_x + TEXT_CHAR_WIDTH > _width) {
+        cursor_x = 0;
+        cursor_y += TEXT_CHAR_HEIGHT;
+      }
+      rasterGlyph(buffer, 0, DISPLAY_PAGES - 1, cursor_x, cursor_y, digitGlyph(digits[--count]), 5, textcolor);
+      cursor_x += TEXT_CHAR_WIDTH;
+    }
+    return;
+  }
+#endif
+  print(value);
+}
+
+void GameDisplay::drawSpritePixels(const Sprite& sprite, int16_t x, int16_t y) {
+  // Pixel by pixel through drawPixel, for rotation and as the reference
+  int16_t left = x - sprite.originX;
+  int16_t top = y - sprite.originY;
+  
+  for (uint8_t i = 0; i < sprite.width; i++) {
+    uint8_t bits = pgm_read_byte(sprite.data + i * 2);
+    uint8_t mask = pgm_read_byte(sprite.data + i * 2 + 1);
+    
+    for (uint8_t row = 0; row < sprite.height; row++) {
+      if (mask & (1 << row)) {
+        drawPixel(left + i, top + row, (bits & (1 << row)) ? SSD1306_WHITE : SSD1306_BLACK);
+      }
+    }
+  }
+}
+
+void GameDisplay::resetFlushStats() {
+  lastFlushBytes = 0;
+  totalFlushBytes = 0;
+  flushCount = 0;
+}
+
+#if !DISPLAY_PAGED
+// Fills go straight to the framebuffer through the raster kernels
+void GameDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (!rasterKernels || !buffer || rotation) {
+    Adafruit_SSD1306::drawFastHLine(x, y, w, color);
+    return;
+  }
+  rasterHLine(buffer, 0, DISPLAY_PAGES - 1, x, y, w, color);
+}
+
+void GameDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (!rasterKernels || !buffer || rotation) {
+    Adafruit_SSD1306::drawFastVLine(x, y, h, color);
+    return;
+  }
+  rasterVLine(buffer, 0, DISPLAY_PAGES - 1, x, y, h, color);
+}
+
+void GameDisplay::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!rasterKernels || !buffer || rotation) {
+    Adafruit_SSD1306::fillRect(x, y, w, h, color);
+    return;
+  }
+  rasterFillRect(buffer, 0, DISPLAY_PAGES - 1, x, y, w, h, color);
+}
+#endif
+
+#if DISPLAY_PAGED
+void GameDisplay::displayPages() {
+  // Part of the frame is missing from the list, the caller redraws it
+  // through displayInPages() rather than showing what was recorded
+  if (displayList.hasOverflowed()) return;
+  
+  lastFlushBytes = 0;
+  wire->setClock(wireClk);
+  
+  // Replaying text moves the cursor, keep the state the game left behind
+  int16_t cursorX = cursor_x;
+  int16_t cursorY = cursor_y;
+  uint16_t color = textcolor;
+  uint16_t bg = textbgcolor;
+  uint8_t sizeX = textsize_x;
+  uint8_t sizeY = textsize_y;
+  bool textWrap = wrap;
+  GFXfont* font = gfxFont;
+  
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    rasterizePage(page);
+    sendPage(page);
+  }
+  
+  cursor_x = cursorX;
+  cursor_y = cursorY;
+  textcolor = color;
+  textbgcolor = bg;
+  textsize_x = sizeX;
+  textsize_y = sizeY;
+  wrap = textWrap;
+  gfxFont = font;
+  
+  wire->setClock(restoreClk);
+  panelValid = true;
+  totalFlushBytes += lastFlushBytes;
+  flushCount++;
+}
+
+// Runs draw once per page with every call rasterized into pageBuffer, for
+// frames with more draw calls than the display list holds.
+void GameDisplay::displayInPages(void (*draw)(void*), void* context) {
+  lastFlushBytes = 0;
+  wire->setClock(wireClk);
+  pagePass = true;
+  
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    memset(pageBuffer, 0, SCREEN_WIDTH);
+    rasterTop = page * 8;
+    rasterizing = true;
+    draw(context);
+    rasterizing = false;
+    sendPage(page);
+  }
+  
+  pagePass = false;
+  wire->setClock(restoreClk);
+  panelValid = true;
+  totalFlushBytes += lastFlushBytes;
+  flushCount++;
+  pagePasses++;
+}
+
+void GameDisplay::sendPage(uint8_t page) {
+#if DISPLAY_PAGED_VERIFY
+  if (memcmp(pageBuffer, buffer + page * SCREEN_WIDTH, SCREEN_WIDTH) != 0) {
+    verifyMismatches++;
+  }
+#endif
+  
+  // No copy of the panel is kept, unchanged pages are found by checksum
+  uint32_t checksum = 2166136261UL;
+  for (uint8_t i = 0; i < SCREEN_WIDTH; i++) {
+    checksum = (checksum ^ pageBuffer[i]) * 16777619UL;
+  }
+  if (panelValid && checksum == pageChecksum[page]) return;
+  
+  pageChecksum[page] = checksum;
+  sendWindow(page, 0, SCREEN_WIDTH - 1, pageBuffer);
+}
+
+void GameDisplay::rasterizePage(uint8_t page) {
+  memset(pageBuffer, 0, SCREEN_WIDTH);
+  rasterTop = page * 8;
+  int16_t rasterBottom = rasterTop + 7;
+  rasterizing = true;
+  gfxFont = NULL;
+  
+  DisplayOp op;
+  uint16_t pos = 0;
+  
+  while (pos < displayList.getLength()) {
+    pos = displayList.read(pos, op);
+    
+    // Ops are skipped early when they cannot reach this page
+    switch (op.type) {
+      case OP_PIXEL:
+        if ((op.y >> 3) == page) rasterFill(op.x, op.y, 1, 1, op.color);
+        break;
+        
+      case OP_FILL_RECT:
+        rasterFill(op.x, op.y, op.w, op.h, op.color);
+        break;
+        
+      case OP_RECT:
+        if (op.y <= rasterBottom && op.y + op.h > rasterTop) {
+          Adafruit_SSD1306::drawRect(op.x, op.y, op.w, op.h, op.color);
+        }
+        break;
+        
+      case OP_LINE:
+        if (min(op.y, op.h) <= rasterBottom && max(op.y, op.h) >= rasterTop) {
+          Adafruit_SSD1306::drawLine(op.x, op.y, op.w, op.h, op.color);
+        }
+        break;
+        
+      case OP_FILL_CIRCLE:
+        if (op.y - op.w <= rasterBottom && op.y + op.w >= rasterTop) {
+          Adafruit_SSD1306::fillCircle(op.x, op.y, op.w, op.color);
+        }
+        break;
+        
+      case OP_CHAR: {
+        textsize_x = op.textSize & 0x07;
+        textsize_y = (op.textSize >> 3) & 0x07;
+        wrap = (op.textSize >> 6) & 0x01;
+        
+        // Built-in font glyphs are 8 rows, a wrap moves them one line down
+        int16_t charBottom = op.y + (wrap ? 16 : 8) * textsize_y - 1;
+        if (!gfxFont && (op.y > rasterBottom || charBottom < rasterTop)) break;
+        
+        cursor_x = op.x;
+        cursor_y = op.y;
+        textcolor = op.color;
+        textbgcolor = (op.bg == DISPLAY_OP_NO_BG) ? op.color : op.bg;
+        Adafruit_SSD1306::write(op.c);
+        break;
+      }
+        
+      case OP_BITMAP:
+        if (op.y <= rasterBottom && op.y + op.h > rasterTop) {
+          Adafruit_SSD1306::drawBitmap(op.x, op.y, (const uint8_t*)op.data, op.w, op.h, op.color);
+        }
+        break;
+        
+      case OP_FONT:
+        gfxFont = (GFXfont*)op.data;
+        break;
+        
+      case OP_SPRITE: {
+        const Sprite* sprite = (const Sprite*)op.data;
+        int16_t top = op.y - sprite->originY;
+        if (top <= rasterBottom && top + sprite->height > rasterTop) {
+          drawSprite(*sprite, op.x, op.y);
+        }
+        break;
+      }
+        
+      case OP_ASSET: {
+        const Asset* asset = (const Asset*)op.data;
+        if (op.y <= rasterBottom && op.y + asset->height > rasterTop) {
+          drawAsset(*asset, op.x, op.y);
+        }
+        break;
+      }
+    }
+  }
+  
+  rasterizing = false;
+}
+
+void GameDisplay::rasterFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  uint8_t page = rasterTop >> 3;
+  rasterFillRect(pageBuffer, page, page, x, y, w, h, color);
+}
+
+// Drawing entry points below record into the display list. Calls that fit
+// one op bump recordDepth so the primitives they are built from are not
+// recorded again; with DISPLAY_PAGED_VERIFY those still reach the framebuffer.
+
+bool GameDisplay::canRecord() {
+  return recording && !rasterizing && recordDepth == 0;
+}
+
+void GameDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (rasterizing) {
+    rasterFill(x, y, 1, 1, color);
+    return;
+  }
+  if (recording) {
+    if (recordDepth == 0) displayList.addPixel(x, y, color);
+    if (!DISPLAY_PAGED_VERIFY) return;
+  }
+  Adafruit_SSD1306::drawPixel(x, y, color);
+}
+
+void GameDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (rasterizing) {
+    rasterFill(x, y, w, 1, color);
+    return;
+  }
+  if (recording) {
+    if (recordDepth == 0) displayList.addFillRect(x, y, w, 1, color);
+    if (!DISPLAY_PAGED_VERIFY) return;
+  }
+  Adafruit_SSD1306::drawFastHLine(x, y, w, color);
+}
+
+void GameDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (rasterizing) {
+    rasterFill(x, y, 1, h, color);
+    return;
+  }
+  if (recording) {
+    if (recordDepth == 0) displayList.addFillRect(x, y, 1, h, color);
+    if (!DISPLAY_PAGED_VERIFY) return;
+  }
+  Adafruit_SSD1306::drawFastVLine(x, y, h, color);
+}
+
+void GameDisplay::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (rasterizing) {
+    rasterFill(x, y, w, h, color);
+    return;
+  }
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addFillRect(x, y, w, h, color)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  Adafruit_SSD1306::fillRect(x, y, w, h, color);
+  recordDepth = depth;
+}
+
+void GameDisplay::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addRect(x, y, w, h, color)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  Adafruit_SSD1306::drawRect(x, y, w, h, color);
+  recordDepth = depth;
+}
+
+void GameDisplay::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addLine(x0, y0, x1, y1, color)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  Adafruit_SSD1306::drawLine(x0, y0, x1, y1, color);
+  recordDepth = depth;
+}
+
+void GameDisplay::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addFillCircle(x0, y0, r, color)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  Adafruit_SSD1306::fillCircle(x0, y0, r, color);
+  recordDepth = depth;
+}
+
+void GameDisplay::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+  uint8_t depth = recordDepth;
+  if (canRecord() && displayList.addBitmap(x, y, bitmap, w, h, color)) {
+    if (!DISPLAY_PAGED_VERIFY) return;
+    recordDepth++;
+  }
+  Adafruit_SSD1306::drawBitmap(x, y, bitmap, w, h, color);
+  recordDepth = depth;
+}
+
+size_t GameDisplay::write(uint8_t c) {
+  uint8_t depth = recordDepth;
+  if (canRecord() && (c == '\n' || c == '\r')) {
+    recordDepth++; // Only moves the cursor
+  } else if (canRecord() && textsize_x < 8 && textsize_y < 8) {
+    uint8_t textSize = textsize_x | (textsize_y << 3) | (wrap << 6);
+    if (displayList.addChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textSize)) {
+      recordDepth++;
+    }
+  }
+  
+  // Always runs to advance the cursor, drawing is dropped when recorded
+  size_t written = Adafruit_SSD1306::write(c);
+  recordDepth = depth;
+  return written;
+}
+
+void GameDisplay::setFont(const GFXfont* f) {
+  if (recording) displayList.addFont(f);
+  Adafruit_SSD1306::setFont(f);
+}
+
+void GameDisplay::clearDisplay() {
+  if (rasterizing) {
+    memset(pageBuffer, 0, SCREEN_WIDTH);
+    return;
+  }
+  if (recording) {
+    displayList.clear();
+    if (gfxFont) displayList.addFont(gfxFont);
+    if (!DISPLAY_PAGED_VERIFY) return;
+  }
+  Adafruit_SSD1306::clearDisplay();
+}
+#endif
 
 void initDisplay() {
   Wire.begin(PIN_SDA, PIN_SCL);
@@ -10,8 +564,11 @@ void initDisplay() {
     for(;;);
   }
   
+  initText();
   display.clearDisplay();
-  display.display();
+  display.displayChanges();
+  
+  framePipeline.begin();
 }
 
 void clearDisplay() {
@@ -19,17 +576,34 @@ void clearDisplay() {
 }
 
 void updateDisplay() {
-  display.display();
+#if !HEADLESS
+#if DISPLAY_PAGED
+  // Each page of a page pass is sent as soon as it is drawn
+  if (display.inPagePass()) return;
+#endif
+  PROFILE_SCOPE(PROFILE_FLUSH);
+  
+#if TRACK_INPUT_LATENCY
+  uint32_t tag = latencyTracker.takeFrameTag();
+#else
+  uint32_t tag = LATENCY_NO_TAG;
+#endif
+  
+  if (framePipeline.isRunning()) {
+    framePipeline.submit(display.getBuffer(), tag);
+  } else {
+    display.displayChanges();
+#if TRACK_INPUT_LATENCY
+    latencyTracker.frameFlushed(tag, micros());
+#endif
+  }
+#endif
 }
 
 void drawCenteredText(const char* text, int y, int textSize) {
   display.setTextSize(textSize);
   display.setTextColor(SSD1306_WHITE);
-  
-  int16_t x1, y1;
-  uint16_t w, h;
-  display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-  display.setCursor((SCREEN_WIDTH - w) / 2, y);
+  display.setCursor(centeredTextX(text, textSize), y);
   display.print(text);
 }
 
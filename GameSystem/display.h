@@ -2,6 +2,103 @@
 #define DISPLAY_H
 
 #include "config.h"
+#include "displaylist.h"
+#include "sprites.h"
+#include "assets.h"
+
+#define DISPLAY_PAGES (SCREEN_HEIGHT / 8)
+#define DISPLAY_BUFFER_SIZE (SCREEN_WIDTH * DISPLAY_PAGES)
+
+// Largest I2C transmission the Wire library can buffer
+#ifdef I2C_BUFFER_LENGTH
+#define DISPLAY_I2C_CHUNK I2C_BUFFER_LENGTH
+#else
+#define DISPLAY_I2C_CHUNK 32
+#endif
+
+// SSD1306 that only sends the parts of the framebuffer that changed.
+// A copy of the panel RAM is kept so each page can be diffed on flush and
+// only the changed column window is pushed over I2C.
+//
+// With DISPLAY_PAGED the framebuffer is released instead: draw calls are
+// recorded into a display list and rasterized one 128 byte page at a time
+// on flush. A frame that overflows the list is not sent; its draw function
+// is run again once per page through displayInPages() instead, straight into
+// pageBuffer. DISPLAY_PAGED_VERIFY keeps the framebuffer and compares every
+// rasterized page against it.
+class GameDisplay : public Adafruit_SSD1306 {
+private:
+#if !DISPLAY_PAGED
+  uint8_t panel[DISPLAY_BUFFER_SIZE]; // What the panel currently shows
+  bool rasterKernels;  // Fills use raster.h instead of the GFX path
+#else
+  DisplayList displayList;
+  uint8_t pageBuffer[SCREEN_WIDTH];
+  uint32_t pageChecksum[DISPLAY_PAGES]; // Checksums of the pages on the panel
+  bool recording;      // Draw calls go to the display list
+  bool rasterizing;    // Draw calls go to pageBuffer
+  bool pagePass;       // Inside displayInPages()
+  uint8_t recordDepth; // Nonzero inside a call already recorded as one op
+  int16_t rasterTop;   // First row of the page being rasterized
+  unsigned long verifyMismatches;
+  unsigned long pagePasses;
+  
+  bool canRecord();
+  void rasterFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void rasterizePage(uint8_t page);
+  void displayPages();
+  void sendPage(uint8_t page);
+#endif
+  bool panelValid;     // False until the panel RAM is known
+  uint16_t lastFlushBytes;
+  unsigned long totalFlushBytes;
+  unsigned long flushCount;
+  
+  void sendWindow(uint8_t page, uint8_t firstColumn, uint8_t lastColumn, const uint8_t* data);
+  void drawSpritePixels(const Sprite& sprite, int16_t x, int16_t y);
+  void drawAssetPixels(const Asset& asset, int16_t x, int16_t y);
+  
+public:
+  GameDisplay(uint8_t w, uint8_t h, TwoWire *twi, int8_t resetPin);
+  bool begin(uint8_t switchvcc, uint8_t i2caddr);
+  void displayChanges();
+#if !DISPLAY_PAGED
+  void displayChanges(const uint8_t* frame);
+#endif
+  void drawSprite(const Sprite& sprite, int16_t x, int16_t y);
+  void drawAsset(const Asset& asset, int16_t x, int16_t y);
+  void printNumber(long value);
+  const GFXfont* getFont() { return gfxFont; }
+  void invalidate() { panelValid = false; }
+  void resetFlushStats();
+  uint16_t getLastFlushBytes() { return lastFlushBytes; }
+  unsigned long getTotalFlushBytes() { return totalFlushBytes; }
+  unsigned long getFlushCount() { return flushCount; }
+  
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+#if !DISPLAY_PAGED
+  void setRasterKernels(bool enabled) { rasterKernels = enabled; }
+#else
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+  size_t write(uint8_t c) override;
+  using Adafruit_GFX::write;
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+  using Adafruit_GFX::drawBitmap;
+  void setFont(const GFXfont* f = NULL);
+  void clearDisplay();
+  void displayInPages(void (*draw)(void*), void* context);
+  bool listOverflowed() { return displayList.hasOverflowed(); }
+  bool inPagePass() { return pagePass; }
+  unsigned long getListOverflows() { return displayList.getOverflows(); }
+  unsigned long getPagePasses() { return pagePasses; }
+  unsigned long getVerifyMismatches() { return verifyMismatches; }
+#endif
+};
 
 void initDisplay();
 void clearDisplay();
@@ -9,114 +106,4 @@ void updateDisplay();
 void drawCenteredText(const char* text, int y, int textSize = 1);
 void drawHighlightBox(int x, int y, int w, int h, bool inverted = false);
 
-
-
-// 'Intro', 128x64px
-const unsigned char epd_bitmap_Intro [] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xf8, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0x7f, 
-	0xff, 0xf0, 0x07, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x3f, 
-	0xff, 0xf7, 0xf3, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xfc, 0x07, 0xd1, 0x9f, 
-	0xff, 0xff, 0xf9, 0xff, 0xff, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xef, 0xff, 0xf3, 0xf3, 0xd0, 0xdf, 
-	0xff, 0xfc, 0x0c, 0x1f, 0xff, 0xff, 0xfe, 0x80, 0x3f, 0xff, 0xff, 0xff, 0xcf, 0xf9, 0xd3, 0x6f, 
-	0xff, 0xfd, 0xe6, 0x07, 0xff, 0xff, 0xfd, 0xff, 0x9f, 0xff, 0xff, 0x00, 0x1c, 0x1c, 0xd0, 0xaf, 
-	0xff, 0xfd, 0xf3, 0xf0, 0x00, 0x00, 0x03, 0xff, 0xc8, 0x3f, 0xfe, 0x00, 0x38, 0x0e, 0x5c, 0x2f, 
-	0xff, 0xfd, 0xfb, 0xff, 0xff, 0xff, 0xff, 0x00, 0x60, 0x00, 0x40, 0xff, 0xf3, 0xe7, 0x06, 0x2f, 
-	0xff, 0xfd, 0xf9, 0x02, 0x00, 0x7f, 0xfe, 0x7e, 0x3f, 0xff, 0xbf, 0xc0, 0xe7, 0xf3, 0xb2, 0x2f, 
-	0xff, 0xfd, 0xfc, 0x7d, 0xef, 0x60, 0x00, 0xff, 0xb0, 0x3f, 0xff, 0x80, 0x4f, 0xf9, 0xdb, 0xef, 
-	0xff, 0xfd, 0xfc, 0x7d, 0xef, 0x2f, 0x79, 0xff, 0xc0, 0x00, 0xe0, 0x7f, 0x4f, 0xfc, 0xe8, 0x0f, 
-	0xff, 0xfd, 0xfe, 0xfd, 0xef, 0x8f, 0x7b, 0xff, 0xcf, 0xce, 0x4e, 0x7f, 0x1f, 0xfe, 0x7f, 0xff, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0x8f, 0x7b, 0xff, 0xcf, 0xcf, 0x1e, 0xff, 0x1f, 0x3e, 0x7f, 0xff, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xff, 0xcf, 0xcf, 0x1e, 0xff, 0x3f, 0x1f, 0x3f, 0xff, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xe7, 0x8f, 0xcf, 0xbe, 0xf0, 0x3f, 0x0e, 0x3f, 0xff, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xc3, 0x9f, 0xcf, 0xfe, 0xf0, 0x3f, 0x0c, 0x3f, 0xff, 
-	0x80, 0x0d, 0xff, 0xfd, 0xef, 0xef, 0x7b, 0xc0, 0x1f, 0xcf, 0xfe, 0xfe, 0x1f, 0xc0, 0x38, 0x03, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9f, 0xcf, 0xfe, 0xfe, 0x1f, 0xe0, 0x3f, 0xff, 
-	0x80, 0x0d, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xef, 0xfe, 0xfe, 0x07, 0xf0, 0x70, 0x01, 
-	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xef, 0xfe, 0xfe, 0x03, 0xf8, 0xff, 0xff, 
-	0xff, 0xfd, 0xff, 0xbd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xee, 0xee, 0xfe, 0x01, 0xfc, 0xff, 0xff, 
-	0xff, 0xfd, 0xf3, 0xbd, 0xef, 0xff, 0x7b, 0xc3, 0x9f, 0xee, 0xee, 0xf0, 0x00, 0xfe, 0x7f, 0xff, 
-	0xff, 0xfd, 0xf1, 0x3d, 0xef, 0x7f, 0x7b, 0xe3, 0x9f, 0xee, 0xce, 0xf0, 0x18, 0x7e, 0x3f, 0xff, 
-	0xff, 0xfd, 0xf0, 0x3d, 0xef, 0x3f, 0x7b, 0xff, 0xbf, 0xee, 0x0e, 0xf0, 0x3e, 0x7e, 0x3f, 0xff, 
-	0xff, 0xfd, 0xf0, 0x3d, 0xef, 0x3f, 0x7b, 0xff, 0xb9, 0xee, 0x0e, 0xff, 0x3f, 0x7e, 0x3f, 0xff, 
-	0xff, 0xfd, 0xf0, 0x1d, 0xef, 0x1f, 0x5a, 0xff, 0xb9, 0xee, 0x0e, 0xff, 0x3f, 0xfe, 0x3f, 0xff, 
-	0xff, 0xfd, 0x90, 0x2d, 0x6f, 0x0f, 0x49, 0xff, 0xb9, 0xee, 0x0c, 0xff, 0x3f, 0xfe, 0x3f, 0xff, 
-	0xff, 0xfd, 0xd2, 0x18, 0xcf, 0x4f, 0x48, 0xfe, 0x39, 0xec, 0x0c, 0xff, 0x1f, 0xfe, 0x3f, 0xff, 
-	0xff, 0xfc, 0x03, 0x80, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x0f, 0xfe, 0x3f, 0xff, 
-	0xff, 0xfe, 0x03, 0x80, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x47, 0xfe, 0x7f, 0xff, 
-	0xff, 0xff, 0x03, 0xc0, 0x10, 0x60, 0x02, 0x00, 0x42, 0x00, 0x70, 0x40, 0x63, 0xfc, 0x3f, 0xff, 
-	0xff, 0xf7, 0x83, 0xe2, 0x18, 0x70, 0xc3, 0x00, 0xc6, 0x00, 0xf8, 0xc8, 0xf1, 0xf8, 0x37, 0xff, 
-	0xff, 0xff, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 
-	0xff, 0xfd, 0xc1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 
-	0x80, 0x01, 0xe1, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe7, 0xfe, 0x01, 0xe0, 0x01, 
-	0xff, 0xff, 0xf0, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe7, 0xff, 0x07, 0xff, 0xff, 
-	0x80, 0x00, 0x7f, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe3, 0xff, 0x8e, 0x80, 0x01, 
-	0x80, 0x00, 0x3f, 0xfc, 0x0c, 0x1c, 0x13, 0x9f, 0xe6, 0x60, 0xc0, 0xc1, 0xff, 0xfc, 0x00, 0x01, 
-	0x80, 0x00, 0x5f, 0xfc, 0xcd, 0xc8, 0x93, 0x3f, 0xe6, 0x64, 0x44, 0xe3, 0xff, 0xf0, 0x00, 0x03, 
-	0xff, 0xf8, 0x0f, 0xfc, 0xcf, 0xc9, 0xf0, 0x7f, 0xe6, 0x66, 0x4c, 0xe7, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xfb, 0xe3, 0xfc, 0xcc, 0x09, 0xf0, 0xff, 0xe6, 0x66, 0x4c, 0xe7, 0xef, 0xff, 0xff, 0xff, 
-	0xff, 0xf2, 0x3b, 0xfc, 0xc9, 0xc9, 0xf0, 0x7f, 0xe6, 0x66, 0x4c, 0xe7, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xf6, 0x0b, 0xfc, 0xc9, 0xc8, 0x91, 0x3f, 0xe0, 0x60, 0x40, 0xe1, 0xff, 0xff, 0x7f, 0xff, 
-	0xfb, 0xf4, 0xcb, 0xfc, 0xcc, 0x0c, 0x33, 0x10, 0x30, 0x60, 0xe0, 0xf1, 0xff, 0xff, 0xbf, 0xff, 
-	0xe5, 0xf4, 0x0a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xdd, 0xf7, 0x5b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 
-	0x3e, 0xf1, 0xb3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0x7c, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xed, 0x7e, 0x0f, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x0f, 0xff, 0x47, 0xff, 0xff, 
-	0xfb, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xff, 0xf8, 0x99, 0xff, 0xff, 
-	0x6e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x3f, 0xf8, 0x34, 0x7f, 0xff, 
-	0xd4, 0x5f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0x5f, 0xf3, 0x6d, 0x9f, 0xff, 
-	0x38, 0x6f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xef, 0xea, 0xaa, 0xaf, 0xff, 
-	0x00, 0xef, 0xfe, 0xf8, 0x1b, 0xff, 0xff, 0xff, 0xc0, 0x7f, 0xdd, 0xb3, 0xe5, 0x55, 0x57, 0xff, 
-	0x01, 0xa7, 0xfd, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xfc, 0x4a, 0xaa, 0xa3, 0xff, 
-	0x03, 0xf9, 0xf3, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xca, 0x89, 0x8a, 0x52, 0x48, 0xff, 
-	0x00, 0x36, 0xef, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0xa5, 0x55, 0x00, 0x00, 0x00, 0x7f, 
-	0x00, 0x0f, 0x1b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf4, 0x92, 0x4a, 0x41, 0x08, 0x42, 0x0f, 
-	0x83, 0x01, 0xae, 0x07, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x76, 0x51, 0x24, 0x00, 0x00, 0x00, 0x03, 
-	0x87, 0x80, 0x1e, 0x01, 0xff, 0xff, 0xff, 0xff, 0xf3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
-	0x8f, 0x60, 0x1f, 0xe0, 0x7f, 0xff, 0xff, 0xff, 0xef, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 'Select', 128x10px
-const unsigned char epd_bitmap_Select [] PROGMEM = {
-	0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xc0, 0x30, 
-	0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x1f, 0xff, 0xff, 0xf0, 0x48, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf8, 0x88, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf9, 0x08, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xfa, 0x08, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xfa, 0x08, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf9, 0x08, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf8, 0x88, 
-	0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x1f, 0xff, 0xff, 0xf0, 0x48, 
-	0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xc0, 0x30
-};
-
-// 'gameheader', 128x14px
-// 'gameheader', 128x20px
-const unsigned char epd_bitmap_gameheader [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x03, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x2a, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0xdc, 0x00, 0x07, 0xc0, 0x00, 0x30, 0xbc, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x2f, 0xff, 0xf0, 0x6c, 0x07, 0xee, 0x6f, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x1f, 0xf8, 0x0f, 0xff, 0xfb, 0x91, 0x37, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x19, 0x2b, 0xf8, 0xfc, 0x03, 0xf0, 0xae, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x90, 0x66, 0xec, 0x60, 0x40, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x92, 0x42, 0x68, 0x66, 0x60, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x97, 0x42, 0x09, 0xe7, 0xe0, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x1d, 0x01, 0x20, 0x97, 0xd2, 0x08, 0x61, 0xee, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x20, 0x97, 0xda, 0x08, 0x70, 0xc0, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x29, 0x20, 0x94, 0x42, 0xa9, 0xf8, 0x40, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x39, 0x2c, 0x96, 0x42, 0xe9, 0xec, 0x60, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x3d, 0x2c, 0xd0, 0x5a, 0xe8, 0x40, 0x60, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x7f, 0xee, 0xf8, 0xda, 0xec, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0xe7, 0xfb, 0xff, 0xff, 0xff, 0xf0, 0x40, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0xdb, 0xff, 0xff, 0x9f, 0xd8, 0xe0, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x07, 0xff, 0x30, 0x00, 0x00, 0x00, 0x00, 0x07, 0x9f, 0xf8, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0x7f, 0xfc, 0x00, 0x00, 0x00
-};
-
-
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,231 @@
+#include "displaylist.h"
+
+// Single byte coordinates cover the screen plus a 64 pixel margin
+#define COORD_BIAS 64
+
+static bool fitsBiased(int16_t v) {
+  return v >= -COORD_BIAS && v <= 255 - COORD_BIAS;
+}
+
+bool DisplayList::reserve(uint16_t bytes) {
+  if (length + bytes > DISPLAY_LIST_SIZE) {
+    overflowed = true;
+    overflows++;
+    return false;
+  }
+  return true;
+}
+
+void DisplayList::putOp(uint8_t type, uint16_t color) {
+  data[length++] = (type << 2) | (color & 0x03);
+}
+
+void DisplayList::putPointer(const void* pointer) {
+  memcpy(&data[length], &pointer, sizeof(pointer));
+  length += sizeof(pointer);
+}
+
+bool DisplayList::addPixel(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return true;
+  if (!reserve(2)) return true;
+  
+  // 1ccxxxxx xxyyyyyy
+  data[length++] = DISPLAY_OP_PIXEL_FLAG | ((color & 0x03) << 5) | (x >> 2);
+  data[length++] = ((x & 0x03) << 6) | y;
+  return true;
+}
+
+bool DisplayList::addFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  // Clip to the screen so the rect fits in bytes
+  int16_t x1 = min(x + w, SCREEN_WIDTH);
+  int16_t y1 = min(y + h, SCREEN_HEIGHT);
+  x = max(x, (int16_t)0);
+  y = max(y, (int16_t)0);
+  if (x >= x1 || y >= y1) return true;
+  if (!reserve(5)) return true;
+  
+  putOp(OP_FILL_RECT, color);
+  data[length++] = x;
+  data[length++] = y;
+  data[length++] = x1 - x;
+  data[length++] = y1 - y;
+  return true;
+}
+
+bool DisplayList::addRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!fitsBiased(x) || !fitsBiased(y) || w < 1 || w > 255 || h < 1 || h > 255) return false;
+  if (!reserve(5)) return true;
+  
+  putOp(OP_RECT, color);
+  data[length++] = x + COORD_BIAS;
+  data[length++] = y + COORD_BIAS;
+  data[length++] = w;
+  data[length++] = h;
+  return true;
+}
+
+bool DisplayList::addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (!fitsBiased(x0) || !fitsBiased(y0) || !fitsBiased(x1) || !fitsBiased(y1)) return false;
+  if (!reserve(5)) return true;
+  
+  putOp(OP_LINE, color);
+  data[length++] = x0 + COORD_BIAS;
+  data[length++] = y0 + COORD_BIAS;
+  data[length++] = x1 + COORD_BIAS;
+  data[length++] = y1 + COORD_BIAS;
+  return true;
+}
+
+bool DisplayList::addFillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  if (!fitsBiased(x0) || !fitsBiased(y0) || r < 0 || r > 255) return false;
+  if (!reserve(4)) return true;
+  
+  putOp(OP_FILL_CIRCLE, color);
+  data[length++] = x0 + COORD_BIAS;
+  data[length++] = y0 + COORD_BIAS;
+  data[length++] = r;
+  return true;
+}
+
+bool DisplayList::addChar(int16_t x, int16_t y, uint8_t c, uint16_t color, uint16_t bg, uint8_t textSize) {
+  if (!fitsBiased(x) || !fitsBiased(y)) return false;
+  if (!reserve(6)) return true;
+  
+  putOp(OP_CHAR, color);
+  data[length++] = x + COORD_BIAS;
+  data[length++] = y + COORD_BIAS;
+  data[length++] = c;
+  data[length++] = textSize;
+  data[length++] = (bg == color) ? DISPLAY_OP_NO_BG : bg;
+  return true;
+}
+
+bool DisplayList::addBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+  if (w < 1 || w > 255 || h < 1 || h > 255) return false;
+  if (!reserve(7 + sizeof(bitmap))) return true;
+  
+  putOp(OP_BITMAP, color);
+  memcpy(&data[length], &x, 2);
+  memcpy(&data[length + 2], &y, 2);
+  data[length + 4] = w;
+  data[length + 5] = h;
+  length += 6;
+  putPointer(bitmap);
+  return true;
+}
+
+bool DisplayList::addFont(const GFXfont* font) {
+  if (!reserve(1 + sizeof(font))) return true;
+  
+  putOp(OP_FONT, 0);
+  putPointer(font);
+  return true;
+}
+
+bool DisplayList::addSprite(int16_t x, int16_t y, const Sprite& sprite) {
+  if (!fitsBiased(x) || !fitsBiased(y)) return false;
+  if (!reserve(4)) return true;
+  
+  putOp(OP_SPRITE, 0);
+  data[length++] = x + COORD_BIAS;
+  data[length++] = y + COORD_BIAS;
+  data[length++] = sprite.id;
+  return true;
+}
+
+bool DisplayList::addAsset(int16_t x, int16_t y, const Asset& asset) {
+  if (!fitsBiased(x) || !fitsBiased(y)) return false;
+  if (!reserve(3 + sizeof(&asset))) return true;
+  
+  putOp(OP_ASSET, 0);
+  data[length++] = x + COORD_BIAS;
+  data[length++] = y + COORD_BIAS;
+  putPointer(&asset);
+  return true;
+}
+
+uint16_t DisplayList::read(uint16_t pos, DisplayOp& op) {
+  uint8_t head = data[pos++];
+  
+  if (head & DISPLAY_OP_PIXEL_FLAG) {
+    uint8_t low = data[pos++];
+    op.type = OP_PIXEL;
+    op.color = (head >> 5) & 0x03;
+    op.x = ((head & 0x1F) << 2) | (low >> 6);
+    op.y = low & 0x3F;
+    return pos;
+  }
+  
+  op.type = head >> 2;
+  op.color = head & 0x03;
+  
+  switch (op.type) {
+    case OP_FILL_RECT:
+      op.x = data[pos];
+      op.y = data[pos + 1];
+      op.w = data[pos + 2];
+      op.h = data[pos + 3];
+      pos += 4;
+      break;
+      
+    case OP_RECT:
+    case OP_LINE:
+      op.x = data[pos] - COORD_BIAS;
+      op.y = data[pos + 1] - COORD_BIAS;
+      if (op.type == OP_RECT) {
+        op.w = data[pos + 2];
+        op.h = data[pos + 3];
+      } else {
+        op.w = data[pos + 2] - COORD_BIAS;
+        op.h = data[pos + 3] - COORD_BIAS;
+      }
+      pos += 4;
+      break;
+      
+    case OP_FILL_CIRCLE:
+      op.x = data[pos] - COORD_BIAS;
+      op.y = data[pos + 1] - COORD_BIAS;
+      op.w = data[pos + 2];
+      pos += 3;
+      break;
+      
+    case OP_CHAR:
+      op.x = data[pos] - COORD_BIAS;
+      op.y = data[pos + 1] - COORD_BIAS;
+      op.c = data[pos + 2];
+      op.textSize = data[pos + 3];
+      op.bg = data[pos + 4];
+      pos += 5;
+      break;
+      
+    case OP_BITMAP:
+      memcpy(&op.x, &data[pos], 2);
+      memcpy(&op.y, &data[pos + 2], 2);
+      op.w = data[pos + 4];
+      op.h = data[pos + 5];
+      memcpy(&op.data, &data[pos + 6], sizeof(op.data));
+      pos += 6 + sizeof(op.data);
+      break;
+      
+    case OP_FONT:
+      memcpy(&op.data, &data[pos], sizeof(op.data));
+      pos += sizeof(op.data);
+      break;
+      
+    case OP_SPRITE:
+      op.x = data[pos] - COORD_BIAS;
+      op.y = data[pos + 1] - COORD_BIAS;
+      op.data = spriteTable[data[pos + 2]];
+      pos += 3;
+      break;
+      
+    case OP_ASSET:
+      op.x = data[pos] - COORD_BIAS;
+      op.y = data[pos + 1] - COORD_BIAS;
+      memcpy(&op.data, &data[pos + 2], sizeof(op.data));
+      pos += 2 + sizeof(op.data);
+      break;
+  }
+  
+  return pos;
+}
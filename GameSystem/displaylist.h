@@ -0,0 +1,77 @@
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include "config.h"
+#include "sprites.h"
+#include "assets.h"
+
+#if SCREEN_WIDTH > 128 || SCREEN_HEIGHT > 64
+#error "Display list pixel encoding assumes a 128x64 panel"
+#endif
+
+// Op types, stored in the top bits of the first byte next to the color.
+// Pixels use a 2 byte form marked by the top bit instead.
+enum DisplayOpType {
+  OP_PIXEL = 0,
+  OP_FILL_RECT,
+  OP_RECT,
+  OP_LINE,
+  OP_FILL_CIRCLE,
+  OP_CHAR,
+  OP_BITMAP,
+  OP_FONT,
+  OP_SPRITE,
+  OP_ASSET
+};
+
+#define DISPLAY_OP_PIXEL_FLAG 0x80
+#define DISPLAY_OP_NO_BG 0xFF // Char drawn without background
+
+// One decoded draw call
+struct DisplayOp {
+  uint8_t type;
+  uint8_t color;
+  int16_t x, y;
+  int16_t w, h;      // Size, line end point or circle radius (w)
+  uint8_t c;         // Character
+  uint8_t textSize;  // size x | size y << 3 | wrap << 6
+  uint8_t bg;        // Text background or DISPLAY_OP_NO_BG
+  const void* data;  // Bitmap, font, sprite or asset
+};
+
+// Compact byte stream of the draw calls made since the last clearDisplay().
+// Coordinates are clipped or biased into single bytes where possible, the
+// add functions return false when a call does not fit the compact form and
+// has to be recorded as the primitives it is made of. Calls that do not fit
+// the remaining space are dropped and flag the list as overflowed.
+class DisplayList {
+private:
+  uint8_t data[DISPLAY_LIST_SIZE];
+  uint16_t length;
+  bool overflowed;     // A call did not fit since the last clear()
+  unsigned long overflows;
+  
+  bool reserve(uint16_t bytes);
+  void putOp(uint8_t type, uint16_t color);
+  void putPointer(const void* pointer);
+  
+public:
+  DisplayList() : length(0), overflowed(false), overflows(0) {}
+  void clear() { length = 0; overflowed = false; }
+  bool addPixel(int16_t x, int16_t y, uint16_t color);
+  bool addFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  bool addRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  bool addLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  bool addFillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  bool addChar(int16_t x, int16_t y, uint8_t c, uint16_t color, uint16_t bg, uint8_t textSize);
+  bool addBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+  bool addFont(const GFXfont* font);
+  bool addSprite(int16_t x, int16_t y, const Sprite& sprite);
+  bool addAsset(int16_t x, int16_t y, const Asset& asset);
+  uint16_t read(uint16_t pos, DisplayOp& op);
+  uint16_t getLength() { return length; }
+  bool hasOverflowed() { return overflowed; }
+  unsigned long getOverflows() { return overflows; }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "config.h"
+
+#define FIXED_FRACTION_BITS 16
+#define FIXED_ONE (1L << FIXED_FRACTION_BITS)
+
+// Signed Q16.16 number for positions and speeds that move by fractions of
+// a pixel. Adding and comparing are plain integer operations, so a game
+// steps to the same bits on the ESP32 and on a PC, which float math does
+// not promise. Ints convert implicitly; floats only through fromFloat(),
+// meant for constants, so no float math sneaks back into a step.
+class Fixed {
+private:
+  int32_t raw;
+  
+  constexpr explicit Fixed(int32_t value, bool) : raw(value) {}
+  
+public:
+  constexpr Fixed() : raw(0) {}
+  constexpr Fixed(int value) : raw((int32_t)value * FIXED_ONE) {}
+  Fixed(float) = delete;
+  Fixed(double) = delete;
+  
+  static constexpr Fixed fromRaw(int32_t value) { return Fixed(value, true); }
+  static constexpr Fixed fromFloat(float value) {
+    return Fixed((int32_t)(value * FIXED_ONE + (value < 0 ? -0.5f : 0.5f)), true);
+  }
+  
+  int32_t getRaw() const { return raw; }
+  int toInt() const { return raw >> FIXED_FRACTION_BITS; } // Rounds down, like a pixel column
+  float toFloat() const { return (float)raw / FIXED_ONE; }
+  Fixed absolute() const { return fromRaw(raw < 0 ? -raw : raw); }
+  
+  Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+  Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+  Fixed operator-() const { return fromRaw(-raw); }
+  
+  friend Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw + b.raw); }
+  friend Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw - b.raw); }
+  friend Fixed operator*(Fixed a, Fixed b) {
+    return fromRaw((int32_t)(((int64_t)a.raw * b.raw) >> FIXED_FRACTION_BITS));
+  }
+  friend Fixed operator*(Fixed a, int b) { return fromRaw(a.raw * b); }
+  friend Fixed operator/(Fixed a, int b) { return fromRaw(a.raw / b); }
+  
+  friend bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+  friend bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+  friend bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+  friend bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+  friend bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+  friend bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+};
+
+#endif
@@ -1,29 +1,37 @@
 #include "flappy.h"
 #include "display.h"
 #include "input.h"
-
-FlappyGame flappyGame;
+#include "frameclock.h"
+#include "replay.h"
+#include "scrolllayer.h"
+#include "background.h"
 
 void FlappyGame::init() {
   // Initialize bird
-  bird.x = 20;
-  bird.y = SCREEN_HEIGHT / 2;
-  bird.velocity = 0;
+  bird.place(20, SCREEN_HEIGHT / 2);
+  bird.velX = 0;
+  bird.velY = 0;
   
   // Initialize pipes
   for (int i = 0; i < MAX_PIPES; i++) {
     pipes[i].x = -1; // Mark as inactive
     pipes[i].passed = false;
+    pipeLayerX[i] = -1;
   }
   
   score = 0;
   gameOver = false;
-  lastUpdate = millis();
-  lastPipeSpawn = millis();
+  frameVersion = 0;
+  physics.begin(PHYSICS_STEP_MS, frameClock.now());
+  lastPipeSpawn = frameClock.now();
   pipeSpawnInterval = 2000; // 2 seconds between pipes
-  gravity = 0.25;
-  jumpStrength = -2.5;
-  gameSpeed = 1.3;
+  gravity = Fixed::fromFloat(0.25);
+  jumpStrength = Fixed::fromFloat(-2.5);
+  gameSpeed = Fixed::fromFloat(1.3);
+  scrollX = 0;
+  scrollFraction = 0;
+  scrollLayer.reset();
+  backgroundCache.invalidate();
   
   // Spawn first pipe
   spawnPipe();
@@ -32,11 +40,18 @@ void FlappyGame::init() {
 void FlappyGame::update() {
   if (gameOver) return;
   
-  unsigned long currentTime = millis();
-  float deltaTime = (currentTime - lastUpdate) / 16.0; // Normalize to ~60fps
-  lastUpdate = currentTime;
+  // The bird is drawn ahead between steps, so every update changes the frame
+  frameVersion++;
   
   handleInput();
+  
+  uint8_t steps = physics.advance(frameClock.now());
+  for (uint8_t i = 0; i < steps && !gameOver; i++) {
+    step(physics.nextStep());
+  }
+}
+
+void FlappyGame::step(unsigned long stepTime) {
   updateBird();
   updatePipes();
   
@@ -45,31 +60,38 @@ void FlappyGame::update() {
   }
   
   // Spawn new pipes
-  if (currentTime - lastPipeSpawn > pipeSpawnInterval) {
+  if (stepTime - lastPipeSpawn > pipeSpawnInterval) {
     spawnPipe();
-    lastPipeSpawn = currentTime;
+    lastPipeSpawn = stepTime;
   }
 }
 
 void FlappyGame::draw() {
-  clearDisplay();
+  if (!backgroundCache.restore()) {
+    clearDisplay();
+    drawGround();
+    backgroundCache.capture();
+  }
   
-  drawGround();
+#if SCROLL_LAYER_ENABLED
+  drawPipeLayer();
+#else
   drawPipes();
+#endif
   drawBird();
   
   // Draw score
   display.setTextSize(1);
   display.setTextColor(SSD1306_WHITE);
   display.setCursor(SCREEN_WIDTH - 30, 5);
-  display.print(score);
+  display.printNumber(score);
   
   updateDisplay();
 }
 
 void FlappyGame::handleInput() {
   if (buttons.upPressed || buttons.rightPressed) {
-    bird.velocity = jumpStrength;
+    bird.velY = jumpStrength;
   }
 }
 
@@ -78,7 +100,7 @@ void FlappyGame::spawnPipe() {
   for (int i = 0; i < MAX_PIPES; i++) {
     if (pipes[i].x < 0) {
       pipes[i].x = SCREEN_WIDTH;
-      pipes[i].gapY = random(15, SCREEN_HEIGHT - PIPE_GAP - 10);
+      pipes[i].gapY = gameRandom(15, SCREEN_HEIGHT - PIPE_GAP - 10);
       pipes[i].passed = false;
       break;
     }
@@ -87,20 +109,26 @@ void FlappyGame::spawnPipe() {
 
 void FlappyGame::updateBird() {
   // Apply gravity
-  bird.velocity += gravity;
-  bird.y += bird.velocity;
+  bird.step(0, gravity);
   
   // Prevent bird from going off screen top
   if (bird.y < 0) {
     bird.y = 0;
-    bird.velocity = 0;
+    bird.velY = 0;
   }
 }
 
 void FlappyGame::updatePipes() {
+  // Pipes move by whole columns with the scroll, so they keep their world
+  // column, and the fraction carries over to the next step
+  scrollFraction += gameSpeed;
+  int shift = scrollFraction.toInt();
+  scrollFraction -= shift;
+  scrollX += shift;
+  
   for (int i = 0; i < MAX_PIPES; i++) {
     if (pipes[i].x >= 0) {
-      pipes[i].x -= gameSpeed;
+      pipes[i].x -= shift;
       
       // Check if bird passed pipe
       if (!pipes[i].passed && pipes[i].x + PIPE_WIDTH < bird.x) {
@@ -108,8 +136,8 @@ void FlappyGame::updatePipes() {
         score++;
         
         // Increase game speed slightly
-        if (gameSpeed < 3.0) {
-          gameSpeed += 0.1;
+        if (gameSpeed < 3) {
+          gameSpeed += Fixed::fromFloat(0.1);
         }
       }
       
@@ -144,11 +172,9 @@ bool FlappyGame::checkCollisions() {
 }
 
 void FlappyGame::drawBird() {
-  // Draw bird as a small filled circle
-  display.fillCircle(bird.x + BIRD_SIZE/2, bird.y + BIRD_SIZE/2, BIRD_SIZE/2, SSD1306_WHITE);
-  
-  // Draw simple wing/eye
-  display.drawPixel(bird.x + 1, bird.y + 1, SSD1306_BLACK);
+  // Small circle with a wing/eye pixel
+  display.drawSprite(spriteBird, bird.x.toInt() + BIRD_SIZE/2,
+                     bird.drawY(physics.alpha()) + BIRD_SIZE/2);
 }
 
 void FlappyGame::drawPipes() {
@@ -168,6 +194,35 @@ void FlappyGame::drawPipes() {
   }
 }
 
+void FlappyGame::drawPipeLayer() {
+  scrollLayer.scrollTo(scrollX);
+  
+  // Pipes that appeared, vanished or did not move with the scroll
+  for (int i = 0; i < MAX_PIPES; i++) {
+    long worldX = (pipes[i].x >= 0) ? scrollX + pipes[i].x : -1;
+    if (worldX == pipeLayerX[i]) continue;
+    
+    if (pipeLayerX[i] >= 0) scrollLayer.markDirty(pipeLayerX[i] - 1, pipeLayerX[i] + PIPE_WIDTH);
+    if (worldX >= 0) scrollLayer.markDirty(worldX - 1, worldX + PIPE_WIDTH);
+    pipeLayerX[i] = worldX;
+  }
+  
+  if (scrollLayer.beginRender()) {
+    for (int i = 0; i < MAX_PIPES; i++) {
+      if (pipes[i].x >= 0) {
+        long x = scrollX + pipes[i].x;
+        scrollLayer.fillRect(x, 0, PIPE_WIDTH, pipes[i].gapY, SSD1306_WHITE);
+        scrollLayer.fillRect(x, pipes[i].gapY + PIPE_GAP, PIPE_WIDTH,
+                             SCREEN_HEIGHT - pipes[i].gapY - PIPE_GAP - 5, SSD1306_WHITE);
+        scrollLayer.fillRect(x - 1, pipes[i].gapY - 3, PIPE_WIDTH + 2, 3, SSD1306_WHITE);
+        scrollLayer.fillRect(x - 1, pipes[i].gapY + PIPE_GAP, PIPE_WIDTH + 2, 3, SSD1306_WHITE);
+      }
+    }
+  }
+  
+  scrollLayer.blit(display.getBuffer(), true);
+}
+
 void FlappyGame::drawGround() {
   // Draw simple ground line
   display.drawLine(0, SCREEN_HEIGHT - 5, SCREEN_WIDTH, SCREEN_HEIGHT - 5, SSD1306_WHITE);
@@ -177,4 +232,25 @@ void FlappyGame::drawGround() {
     display.drawPixel(x, SCREEN_HEIGHT - 4, SSD1306_WHITE);
     display.drawPixel(x + 2, SCREEN_HEIGHT - 3, SSD1306_WHITE);
   }
-}
\ No newline at end of file
+}
+
+void FlappyGame::serialize(SaveStream& state) {
+  bird.serialize(state);
+  physics.serialize(state);
+  for (int i = 0; i < MAX_PIPES; i++) {
+    state.value(pipes[i].x);
+    state.value(pipes[i].gapY);
+    state.value(pipes[i].passed);
+  }
+  state.value(score);
+  state.value(gameOver);
+  state.time(lastPipeSpawn);
+  state.value(pipeSpawnInterval);
+  state.value(gravity);
+  state.value(jumpStrength);
+  state.value(gameSpeed);
+  state.value(scrollX);
+  state.value(scrollFraction);
+  
+  // The pipe layer is drawn again from scratch, init() emptied it
+}
@@ -2,17 +2,13 @@
 #define FLAPPY_H
 
 #include "config.h"
+#include "physics.h"
 
 #define BIRD_SIZE 3
 #define PIPE_WIDTH 8
 #define PIPE_GAP 20
 #define MAX_PIPES 3
 
-struct Bird {
-  float x, y;
-  float velocity;
-};
-
 struct Pipe {
   int x;
   int gapY;
@@ -21,23 +17,29 @@ struct Pipe {
 
 class FlappyGame {
 private:
-  Bird bird;
+  Body bird;
+  PhysicsClock physics;
   Pipe pipes[MAX_PIPES];
   int score;
   bool gameOver;
-  unsigned long lastUpdate;
+  unsigned long frameVersion;
   unsigned long lastPipeSpawn;
   int pipeSpawnInterval;
-  float gravity;
-  float jumpStrength;
-  float gameSpeed;
+  Fixed gravity;
+  Fixed jumpStrength;
+  Fixed gameSpeed;
+  long scrollX;                // World column at the left screen edge
+  Fixed scrollFraction;        // Sub-pixel scroll not yet a whole column
+  long pipeLayerX[MAX_PIPES];  // World column each pipe was drawn at, -1 if none
   
   void spawnPipe();
+  void step(unsigned long stepTime);
   void updateBird();
   void updatePipes();
   bool checkCollisions();
   void drawBird();
   void drawPipes();
+  void drawPipeLayer();
   void drawGround();
   
 public:
@@ -45,11 +47,13 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  bool isGameWon() { return false; }
+  unsigned long getFrameVersion() { return frameVersion; }
   int getScore() { return score; }
   const char* getName() { return "FLAPPY BIRD"; }
+  const Body& getBird() { return bird; }
 };
 
-extern FlappyGame flappyGame;
-
 #endif
@@ -0,0 +1,21 @@
+#include "frameclock.h"
+
+FrameClock frameClock;
+
+void FrameClock::begin(bool useVirtualTime) {
+  virtualTime = useVirtualTime;
+  virtualMicros = 0;
+  frameMillis = wallMicros() / 1000;
+}
+
+unsigned long FrameClock::wallMicros() {
+  return virtualTime ? virtualMicros : micros();
+}
+
+void FrameClock::sleep(unsigned long ms) {
+  if (virtualTime) {
+    virtualMicros += ms * 1000UL;
+  } else {
+    delay(ms);
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef FRAMECLOCK_H
+#define FRAMECLOCK_H
+
+#include "config.h"
+
+// Time the games see, in milliseconds. It moves by GAME_TICK_MS for every
+// game tick, so everything in a tick sees the same time and game speed
+// follows the number of ticks rather than how long the frames took.
+// The scheduler paces the ticks against wall time, which is micros() on
+// the device or a virtual clock in HEADLESS builds that only moves when
+// the loop sleeps, so game logic runs as fast as the host allows.
+class FrameClock {
+private:
+  unsigned long frameMillis;    // Game time of the current tick
+  unsigned long virtualMicros;
+  bool virtualTime;
+  
+public:
+  FrameClock() : frameMillis(0), virtualMicros(0), virtualTime(false) {}
+  void begin(bool useVirtualTime);
+  void advance(unsigned long ms) { frameMillis += ms; }
+  void set(unsigned long time) { frameMillis = time; } // Replays bring their own time
+  unsigned long now() { return frameMillis; }
+  unsigned long wallMicros();
+  void sleep(unsigned long ms);
+  bool isVirtual() { return virtualTime; }
+};
+
+extern FrameClock frameClock;
+
+#endif
@@ -0,0 +1,126 @@
+#include "framepipeline.h"
+#include "latency.h"
+
+FramePipeline framePipeline;
+
+void FramePipeline::begin() {
+#if FRAME_PIPELINE_ENABLED && !defined(ESP32)
+  // A host test can start the display again, the old thread goes first
+  end();
+#endif
+  back = 0;
+  shared = 1;
+  front = 2;
+  memset(frameTags, 0, sizeof(frameTags));
+  framesProduced = 0;
+  framesFlushed = 0;
+  resetStats();
+  running = false;
+  
+#if FRAME_PIPELINE_ENABLED && defined(ESP32)
+  // Loop runs on the other core, I2C transfers happen here
+  if (xTaskCreatePinnedToCore(flushTaskMain, "flush", 4096, this, 1,
+                              &flushTask, DISPLAY_FLUSH_CORE) == pdPASS) {
+    running = true;
+  } else {
+    Serial.println(F("Flush task failed, flushing on the game loop"));
+  }
+#elif FRAME_PIPELINE_ENABLED
+  wakePending = false;
+  stopping = false;
+  flushThread = std::thread(flushTaskMain, this);
+  running = true;
+#endif
+}
+
+#if FRAME_PIPELINE_ENABLED && !defined(ESP32)
+void FramePipeline::end() {
+  if (!flushThread.joinable()) return;
+  
+  // Frames already submitted are flushed before the thread stops
+  stopping = true;
+  wakeFlushTask();
+  flushThread.join();
+  running = false;
+}
+#endif
+
+void FramePipeline::submit(const uint8_t* frame, uint32_t tag) {
+#if FRAME_PIPELINE_ENABLED
+  memcpy(frames[back], frame, DISPLAY_BUFFER_SIZE);
+  
+  // A frame the flush task has not picked up is replaced by this one, which
+  // then is the first to show its press. Taking the fresh flag off first
+  // keeps the flush task from picking it up while the tag moves over.
+  int waiting = shared.load();
+  if ((waiting & FRAME_FRESH) && shared.compare_exchange_strong(waiting, waiting & ~FRAME_FRESH)) {
+    tag = olderLatencyTag(frameTags[waiting & ~FRAME_FRESH], tag);
+  }
+  frameTags[back] = tag;
+  
+  // Publish the finished frame and take back whatever slot was shared
+  int previous = shared.exchange(back | FRAME_FRESH);
+  back = previous & ~FRAME_FRESH;
+  framesProduced++;
+  
+  wakeFlushTask();
+#endif
+}
+
+bool FramePipeline::acquire() {
+  // Only a fresh slot is swapped, submit() may take the flag off meanwhile
+  int previous = shared.load();
+  do {
+    if (!(previous & FRAME_FRESH)) return false;
+  } while (!shared.compare_exchange_weak(previous, front));
+  
+  front = previous & ~FRAME_FRESH;
+  return true;
+}
+
+void FramePipeline::resetStats() {
+  producedBase = framesProduced;
+  flushedBase = framesFlushed;
+}
+
+#if FRAME_PIPELINE_ENABLED
+void FramePipeline::wakeFlushTask() {
+#ifdef ESP32
+  xTaskNotifyGive(flushTask);
+#else
+  wakePending = true;
+#endif
+}
+
+bool FramePipeline::waitForFrame() {
+#ifdef ESP32
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  return true;
+#else
+  // Short sleeps rather than a condition variable, end() is all the
+  // teardown the thread needs
+  while (!wakePending.exchange(false)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return !stopping;
+#endif
+}
+
+void FramePipeline::flushTaskMain(void* arg) {
+  FramePipeline* pipeline = (FramePipeline*)arg;
+  
+  for (;;) {
+    bool keepRunning = pipeline->waitForFrame();
+    
+    // Frames submitted while we were busy are skipped, only the newest is sent
+    while (pipeline->acquire()) {
+      display.displayChanges(pipeline->frames[pipeline->front]);
+      pipeline->framesFlushed++;
+#if TRACK_INPUT_LATENCY
+      latencyTracker.frameFlushed(pipeline->frameTags[pipeline->front], micros());
+#endif
+    }
+    if (!keepRunning) return;
+  }
+}
+#endif
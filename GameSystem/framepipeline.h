@@ -0,0 +1,70 @@
+#ifndef FRAMEPIPELINE_H
+#define FRAMEPIPELINE_H
+
+#include "config.h"
+#include "display.h"
+#include <atomic>
+
+#if DISPLAY_PIPELINE && !DISPLAY_PAGED
+#define FRAME_PIPELINE_ENABLED 1
+#else
+#define FRAME_PIPELINE_ENABLED 0
+#endif
+
+// A FreeRTOS task on the ESP32, a thread standing in for it on a host build
+#if FRAME_PIPELINE_ENABLED && !defined(ESP32)
+#include <thread>
+#endif
+
+#define FRAME_FRESH 0x4 // Set on the shared slot when it holds an unflushed frame
+
+// Triple buffer between the game loop and the flush task on the other core.
+// The game loop always has a free slot to render into and the flush task
+// always picks up the newest finished frame, so neither side waits. Host
+// builds run the flush task on a std::thread.
+class FramePipeline {
+private:
+#if FRAME_PIPELINE_ENABLED
+  uint8_t frames[3][DISPLAY_BUFFER_SIZE];
+#endif
+  uint32_t frameTags[3];   // Latency tag of the frame in each slot
+  std::atomic<int> shared; // Slot handed between the two sides
+  int back;                // Slot owned by the game loop
+  int front;               // Slot owned by the flush task
+  volatile unsigned long framesProduced;
+  volatile unsigned long framesFlushed;
+  unsigned long producedBase;
+  unsigned long flushedBase;
+  bool running;
+  
+#if FRAME_PIPELINE_ENABLED
+#ifdef ESP32
+  TaskHandle_t flushTask;
+#else
+  std::thread flushThread;
+  std::atomic<bool> wakePending;  // Stands in for the task notification
+  std::atomic<bool> stopping;
+#endif
+  
+  static void flushTaskMain(void* arg);
+  void wakeFlushTask();
+  bool waitForFrame();
+#endif
+  bool acquire();
+  
+public:
+  void begin();
+#if FRAME_PIPELINE_ENABLED && !defined(ESP32)
+  ~FramePipeline() { end(); }  // A joinable std::thread aborts the program
+  void end();  // Joins the flush thread, so a host test can exit cleanly
+#endif
+  void submit(const uint8_t* frame, uint32_t tag);
+  bool isRunning() { return running; }
+  void resetStats();
+  unsigned long getFramesProduced() { return framesProduced - producedBase; }
+  unsigned long getFramesFlushed() { return framesFlushed - flushedBase; }
+};
+
+extern FramePipeline framePipeline;
+
+#endif
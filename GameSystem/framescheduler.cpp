@@ -0,0 +1,63 @@
+#include "framescheduler.h"
+#include "frameclock.h"
+#include "logger.h"
+
+FrameScheduler frameScheduler;
+
+void FrameScheduler::begin() {
+  // The first tick is due right away and game time starts from the wall
+  lastMicros = frameClock.wallMicros();
+  accumulator = GAME_TICK_MICROS;
+  frameClock.set(lastMicros / 1000 - GAME_TICK_MS);
+  resetStats();
+}
+
+uint8_t FrameScheduler::dueTicks() {
+  unsigned long now = frameClock.wallMicros();
+  accumulator += now - lastMicros;
+  lastMicros = now;
+  if (accumulator < GAME_TICK_MICROS) return 0;
+  
+  unsigned long due = accumulator / GAME_TICK_MICROS;
+  accumulator -= due * GAME_TICK_MICROS;
+  if (due > MAX_CATCHUP_TICKS) {
+    droppedTicks += due - MAX_CATCHUP_TICKS;
+    due = MAX_CATCHUP_TICKS;
+  }
+  
+  // What is left over is how late this frame starts
+  frames++;
+  ticks += due;
+  catchUpTicks += due - 1;
+  lateTotal += accumulator;
+  if (accumulator > lateMax) lateMax = accumulator;
+  return due;
+}
+
+void FrameScheduler::sleep() {
+  unsigned long busy = frameClock.wallMicros() - lastMicros;
+  if (accumulator + busy >= GAME_TICK_MICROS) {
+    // No time left in this tick, go straight to the next frame
+    overruns++;
+    return;
+  }
+  
+  // Idle time, print what was logged during the frame
+  drainLog();
+  busy = frameClock.wallMicros() - lastMicros;
+  if (accumulator + busy >= GAME_TICK_MICROS) return;
+  
+  // Rounded up to whole milliseconds, waking late shows up as lateness
+  unsigned long remaining = GAME_TICK_MICROS - accumulator - busy;
+  frameClock.sleep((remaining + 999) / 1000);
+}
+
+void FrameScheduler::resetStats() {
+  frames = 0;
+  ticks = 0;
+  catchUpTicks = 0;
+  droppedTicks = 0;
+  overruns = 0;
+  lateTotal = 0;
+  lateMax = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include "config.h"
+
+#define GAME_TICK_MICROS (GAME_TICK_MS * 1000UL)
+
+// Paces the game loop at a fixed tick. Elapsed wall time goes into an
+// accumulator and every full GAME_TICK_MS in it is one game tick, so after
+// a slow frame the missed ticks run back to back before the next draw.
+// Past MAX_CATCHUP_TICKS the rest is dropped and the game slows down
+// instead of falling further behind. What is left of the tick after the
+// frame's work is slept away.
+class FrameScheduler {
+private:
+  unsigned long lastMicros;   // Wall time the accumulator was last filled
+  unsigned long accumulator;  // Wall time not yet turned into ticks
+  unsigned long frames;
+  unsigned long ticks;
+  unsigned long catchUpTicks; // Ticks run beyond one per frame
+  unsigned long droppedTicks;
+  unsigned long overruns;     // Frames whose work took longer than a tick
+  unsigned long lateTotal;    // How far frames started past their tick
+  unsigned long lateMax;
+  
+public:
+  void begin();
+  uint8_t dueTicks();
+  void sleep();
+  void resetStats();
+  unsigned long getFrames() { return frames; }
+  unsigned long getTicks() { return ticks; }
+  unsigned long getCatchUpTicks() { return catchUpTicks; }
+  unsigned long getDroppedTicks() { return droppedTicks; }
+  unsigned long getOverruns() { return overruns; }
+  unsigned long getMeanLateness() { return frames ? lateTotal / frames : 0; }
+  unsigned long getMaxLateness() { return lateMax; }
+};
+
+extern FrameScheduler frameScheduler;
+
+#endif
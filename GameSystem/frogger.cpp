@@ -1,8 +1,10 @@
 #include "frogger.h"
+#include "logger.h"
 #include "display.h"
 #include "input.h"
-
-FroggerGame froggerGame;
+#include "frameclock.h"
+#include "replay.h"
+#include "background.h"
 
 void FroggerGame::init() {
   resetFrog();
@@ -20,15 +22,24 @@ void FroggerGame::init() {
   score = 0;
   lives = 3;
   gameOver = false;
-  lastUpdate = millis();
-  lastSpawn = millis();
+  frameVersion = 0;
+  lastUpdate = frameClock.now();
+  lastSpawn = frameClock.now();
   highestY = SCREEN_HEIGHT - SAFE_ZONE_HEIGHT;
+  backgroundCache.invalidate();
 }
 
 void FroggerGame::update() {
+  // Input, obstacles and collisions can all move something on screen,
+  // so the frame only counts as unchanged when none of them did
+  int frogX = frog.x;
+  int frogY = frog.y;
+  int livesBefore = lives;
+  int scoreBefore = score;
+  
   handleInput();
   
-  unsigned long currentTime = millis();
+  unsigned long currentTime = frameClock.now();
   
   if (currentTime - lastUpdate > 100) { // 10 FPS for smooth movement
     updateCars();
@@ -43,6 +54,7 @@ void FroggerGame::update() {
     }
     
     lastUpdate = currentTime;
+    frameVersion++;
   }
   
   // Check collisions
@@ -64,12 +76,19 @@ void FroggerGame::update() {
     }
     resetFrog();
   }
+  
+  if (frog.x != frogX || frog.y != frogY || lives != livesBefore || score != scoreBefore) {
+    frameVersion++;
+  }
 }
 
 void FroggerGame::draw() {
-  clearDisplay();
+  if (!backgroundCache.restore()) {
+    clearDisplay();
+    drawRoad();
+    backgroundCache.capture();
+  }
   
-  drawRoad();
   drawCars();
   drawLogs();
   drawFrog();
@@ -119,15 +138,7 @@ void FroggerGame::updateFrog() {
   if (frog.x < 0) frog.x = 0;
   if (frog.x > SCREEN_WIDTH - FROG_SIZE) frog.x = SCREEN_WIDTH - FROG_SIZE;
   
-  // Debug info
-  Serial.print("Frog: ");
-  Serial.print(frog.x);
-  Serial.print(",");
-  Serial.print(frog.y);
-  Serial.print(" OnLog: ");
-  Serial.print(frog.onLog);
-  Serial.print(" LogIndex: ");
-  Serial.println(frog.logIndex);
+  LOG_DEBUG("Frog: %d,%d OnLog: %d LogIndex: %d", frog.x, frog.y, frog.onLog, frog.logIndex);
 }
 
 void FroggerGame::updateCars() {
@@ -162,10 +173,10 @@ void FroggerGame::spawnCar() {
       // Cars only in road area: bottom safe zone up to river
       int roadStartY = SCREEN_HEIGHT - SAFE_ZONE_HEIGHT - (ROAD_LANES * LANE_HEIGHT);
       int roadEndY = SCREEN_HEIGHT - SAFE_ZONE_HEIGHT;
-      cars[i].y = roadStartY + (random(0, ROAD_LANES) * LANE_HEIGHT);
+      cars[i].y = roadStartY + (gameRandom(0, ROAD_LANES) * LANE_HEIGHT);
       
-      cars[i].direction = random(0, 2);
-      cars[i].speed = random(1, 3);
+      cars[i].direction = gameRandom(0, 2);
+      cars[i].speed = gameRandom(1, 3);
       
       if (cars[i].direction) {
         cars[i].x = -8;
@@ -182,9 +193,9 @@ void FroggerGame::spawnLog() {
     if (!logs[i].active) {
       logs[i].active = true;
       // Logs only in river area: safe zone to safe zone + river lanes
-      logs[i].y = SAFE_ZONE_HEIGHT + (random(0, RIVER_LANES) * LANE_HEIGHT);
-      logs[i].width = random(20, 40); // Longer logs for easier gameplay
-      logs[i].speed = random(1, 2); // Slower speed
+      logs[i].y = SAFE_ZONE_HEIGHT + (gameRandom(0, RIVER_LANES) * LANE_HEIGHT);
+      logs[i].width = gameRandom(20, 40); // Longer logs for easier gameplay
+      logs[i].speed = gameRandom(1, 2); // Slower speed
       logs[i].x = -logs[i].width;
       break;
     }
@@ -242,19 +253,14 @@ bool FroggerGame::checkWaterCollision() {
 }
 
 void FroggerGame::drawFrog() {
-  display.fillRect(frog.x, frog.y, FROG_SIZE, FROG_SIZE, SSD1306_WHITE);
-  // Draw simple eyes
-  display.drawPixel(frog.x + 1, frog.y + 1, SSD1306_BLACK);
-  display.drawPixel(frog.x + 3, frog.y + 1, SSD1306_BLACK);
+  // Square with simple eyes
+  display.drawSprite(spriteFrog, frog.x, frog.y);
 }
 
 void FroggerGame::drawCars() {
   for (int i = 0; i < MAX_CARS; i++) {
     if (cars[i].active) {
-      display.fillRect(cars[i].x, cars[i].y, 8, 6, SSD1306_WHITE);
-      // Draw windows
-      display.drawPixel(cars[i].x + 2, cars[i].y + 2, SSD1306_BLACK);
-      display.drawPixel(cars[i].x + 6, cars[i].y + 2, SSD1306_BLACK);
+      display.drawSprite(spriteCar, cars[i].x, cars[i].y); // Body with windows
     }
   }
 }
@@ -307,10 +313,37 @@ void FroggerGame::drawUI() {
   // Score
   display.setCursor(0, 0);
   display.print(F("Score:"));
-  display.print(score);
+  display.printNumber(score);
   
   // Lives
   display.setCursor(SCREEN_WIDTH - 45, 0);
   display.print(F("Lives:"));
-  display.print(lives);
-}
\ No newline at end of file
+  display.printNumber(lives);
+}
+
+void FroggerGame::serialize(SaveStream& state) {
+  state.value(frog.x);
+  state.value(frog.y);
+  state.value(frog.onLog);
+  state.value(frog.logIndex);
+  for (int i = 0; i < MAX_CARS; i++) {
+    state.value(cars[i].x);
+    state.value(cars[i].y);
+    state.value(cars[i].speed);
+    state.value(cars[i].active);
+    state.value(cars[i].direction);
+  }
+  for (int i = 0; i < MAX_LOGS; i++) {
+    state.value(logs[i].x);
+    state.value(logs[i].y);
+    state.value(logs[i].width);
+    state.value(logs[i].speed);
+    state.value(logs[i].active);
+  }
+  state.value(score);
+  state.value(lives);
+  state.value(gameOver);
+  state.time(lastUpdate);
+  state.time(lastSpawn);
+  state.value(highestY);
+}
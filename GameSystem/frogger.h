@@ -2,6 +2,7 @@
 #define FROGGER_H
 
 #include "config.h"
+#include "savestate.h"
 
 #define FROG_SIZE 4
 #define ROAD_LANES 3
@@ -39,6 +40,7 @@ private:
   int score;
   int lives;
   bool gameOver;
+  unsigned long frameVersion;
   unsigned long lastUpdate;
   unsigned long lastSpawn;
   int highestY;
@@ -62,11 +64,12 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  bool isGameWon() { return false; }
+  unsigned long getFrameVersion() { return frameVersion; }
   int getScore() { return score; }
   const char* getName() { return "FROGGER"; }
 };
 
-extern FroggerGame froggerGame;
-
 #endif
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include "game2048.h"
 #include "display.h"
 #include "input.h"
-
-Game2048 game2048;
+#include "frameclock.h"
+#include "replay.h"
 
 void Game2048::init() {
   // Clear grid
@@ -14,6 +14,7 @@ void Game2048::init() {
   
   score = 0;
   gameOver = false;
+  frameVersion = 0;
   hasWon = false;
   moved = false;
   
@@ -28,6 +29,7 @@ void Game2048::update() {
   if (moved) {
     addRandomTile();
     moved = false;
+    frameVersion++;
     
     if (!canMove()) {
       gameOver = true;
@@ -44,7 +46,7 @@ void Game2048::draw() {
   display.setCursor(0, 0);
   display.print(F("Score:"));
   display.setCursor(0, 10);
-  display.print(score);
+  display.printNumber(score);
   
   // Draw grid
   for (int y = 0; y < GRID_SIZE_2048; y++) {
@@ -93,12 +95,12 @@ void Game2048::addRandomTile() {
   }
   
   if (count > 0) {
-    int index = random(0, count);
+    int index = gameRandom(0, count);
     int x = emptyCells[index][0];
     int y = emptyCells[index][1];
     
     // 90% chance for 2, 10% chance for 4
-    grid[y][x] = (random(0, 10) < 9) ? 2 : 4;
+    grid[y][x] = (gameRandom(0, 10) < 9) ? 2 : 4;
   }
 }
 
@@ -272,10 +274,10 @@ void Game2048::drawTile(int x, int y, int value) {
     
     display.setCursor(textX, textY);
     if (value >= 1000) {
-      display.print(value / 1000);
+      display.printNumber(value / 1000);
       display.print(F("k"));
     } else {
-      display.print(value);
+      display.printNumber(value);
     }
   }
 }
@@ -285,4 +287,16 @@ int Game2048::getTileWidth(int value) {
   if (value < 100) return 12;
   if (value < 1000) return 18;
   return 12; // For "1k", "2k", etc.
-}
\ No newline at end of file
+}
+
+void Game2048::serialize(SaveStream& state) {
+  for (int y = 0; y < GRID_SIZE_2048; y++) {
+    for (int x = 0; x < GRID_SIZE_2048; x++) {
+      state.value(grid[y][x]);
+    }
+  }
+  state.value(score);
+  state.value(gameOver);
+  state.value(hasWon);
+  state.value(moved);
+}
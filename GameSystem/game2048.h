@@ -2,6 +2,7 @@
 #define GAME2048_H
 
 #include "config.h"
+#include "savestate.h"
 
 #define GRID_SIZE_2048 4
 #define TILE_SIZE 14
@@ -14,6 +15,7 @@ private:
   int grid[GRID_SIZE_2048][GRID_SIZE_2048];
   int score;
   bool gameOver;
+  unsigned long frameVersion;
   bool hasWon;
   bool moved;
   
@@ -34,12 +36,12 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  unsigned long getFrameVersion() { return frameVersion; }
   bool isGameWon() { return hasWon; }
   int getScore() { return score; }
   const char* getName() { return "2048"; }
 };
 
-extern Game2048 game2048;
-
 #endif
\ No newline at end of file
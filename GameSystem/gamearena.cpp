@@ -0,0 +1,49 @@
+#include "gamearena.h"
+#include "logger.h"
+
+GameArena gameArena;
+
+static_assert(GameRegistry::count < 2 || GAME_ARENA_SIZE < totalGameSize(),
+              "the arena should be smaller than all games together");
+
+#if REPORT_GAME_FOOTPRINT
+// Calling report() makes the compiler print a warning naming the game and
+// its size, e.g. "[with GameID Game = GAME_SNAKE; unsigned int Bytes = 412]"
+template <GameID Game, size_t Bytes>
+struct GameFootprint {
+  [[deprecated("game footprint report, see Game and Bytes")]] static void report() {}
+};
+
+// One warning per registered game
+template <int Index>
+struct FootprintReport {
+  static void report() {
+    GameFootprint<GameRegistry::games[Index].id, GameRegistry::games[Index].size>::report();
+    FootprintReport<Index + 1>::report();
+  }
+};
+
+template <>
+struct FootprintReport<GameRegistry::count> {
+  static void report() {}
+};
+#endif
+
+void GameArena::start(const GameEntry& entry) {
+  stop();
+  entry.construct(slot);
+  game = &entry;
+}
+
+void GameArena::stop() {
+  if (game) game->destroy(slot);
+  game = NULL;
+}
+
+void GameArena::reportFootprint() {
+#if REPORT_GAME_FOOTPRINT
+  FootprintReport<0>::report();
+#endif
+  
+  LOG_INFO("Game arena: %u bytes, %u with every game resident", GAME_ARENA_SIZE, totalGameSize());
+}
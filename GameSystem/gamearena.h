@@ -0,0 +1,29 @@
+#ifndef GAMEARENA_H
+#define GAMEARENA_H
+
+#include "config.h"
+#include "gameregistry.h"
+
+#define GAME_ARENA_SIZE largestGameSize()
+
+// RAM of the game being played. GameManager only ever runs one game, so
+// instead of a resident global per game the registered games take turns in
+// one slot the size of the largest: start() destroys the game in it and
+// constructs the next in place.
+class GameArena {
+private:
+  alignas(largestGameAlign()) uint8_t slot[GAME_ARENA_SIZE];
+  const GameEntry* game;  // Game alive in the slot, NULL for none
+  
+public:
+  GameArena() : game(NULL) {}
+  void start(const GameEntry& entry);
+  void stop();
+  const GameEntry* getGame() { return game; }
+  void* getData() { return slot; }
+  void reportFootprint();
+};
+
+extern GameArena gameArena;
+
+#endif
@@ -1,8 +1,27 @@
 #include "gamemanager.h"
 #include "display.h"
 #include "input.h"
+#include "framepipeline.h"
+#include "background.h"
+#include "text.h"
+#include "latency.h"
+#include "replay.h"
+#include "framescheduler.h"
+#include "profiler.h"
+#include "savestate.h"
+#include "logger.h"
 GameManager gameManager;
 
+// Fixed end screen lines, centered once
+static CenteredText gameOverTitle = {"GAME OVER", 2};
+static CenteredText gameWonTitle = {"YOU WON!", 2};
+static CenteredText newHighscoreText = {"NEW HIGHSCORE!", 1};
+static CenteredText menuHint = {"UP: Menu", 1};
+static CenteredText restartHint = {"RIGHT: Restart", 1};
+static CenteredText playAgainHint = {"RIGHT: Play Again", 1};
+static CenteredText pausedTitle = {"PAUSED", 2};
+static CenteredText resumeHint = {"RIGHT: Resume", 1};
+
 void initGameManager() {
   gameManager.init();
 }
@@ -11,15 +30,32 @@ void updateGameManager() {
   gameManager.update();
 }
 
+void renderGameManager() {
+  gameManager.render();
+}
+
 void GameManager::init() {
   currentState = STATE_MENU;
   currentGame = 0;
   menuSelection = 0;
   menuScroll = 0;
   newHighscore = false;
+  frameMicros = 0;
+  frameCount = 0;
+  framesSkipped = 0;
+  forceDraw = true;
   
-  // Initialize highscore system
+  // Loaded during boot already unless GameManager starts on its own
   initHighscores();
+  gameArena.reportFootprint();
+  
+  // A game suspended before the last reset waits on the pause screen
+  if (saveState.loadStored()) {
+    currentGame = saveState.getGame();
+    menuSelection = GameRegistry::indexOf(currentGame);
+    setState(STATE_PAUSED);
+    return;
+  }
   
   showMenu();
 }
@@ -30,86 +66,31 @@ void GameManager::update() {
       handleMenuInput();
       break;
       
-    case STATE_PLAYING:
-      switch (currentGame) {
-        case GAME_SNAKE:
-          snakeGame.update();
-          snakeGame.draw();
-          if (snakeGame.isGameOver()) {
-            setState(STATE_GAME_OVER);
-          }
-          break;
-          
-        case GAME_TETRIS:
-          tetrisGame.update();
-          tetrisGame.draw();
-          if (tetrisGame.isGameOver()) {
-            setState(STATE_GAME_OVER);
-          }
-          break;
-          
-        case GAME_FLAPPY:
-          flappyGame.update();
-          flappyGame.draw();
-          if (flappyGame.isGameOver()) {
-            setState(STATE_GAME_OVER);
-          }
-          break;
-          
-        case GAME_2048:
-          game2048.update();
-          game2048.draw();
-          if (game2048.isGameOver()) {
-            if (game2048.isGameWon()) {
-              setState(STATE_GAME_WON);
-            } else {
-              setState(STATE_GAME_OVER);
-            }
-          }
-          break;
-          
-        case GAME_BREAKOUT:
-          breakoutGame.update();
-          breakoutGame.draw();
-          if (breakoutGame.isGameOver()) {
-            if (breakoutGame.isGameWon()) {
-              setState(STATE_GAME_WON);
-            } else {
-              setState(STATE_GAME_OVER);
-            }
-          }
-          break;
-          
-        case GAME_FROGGER:
-          froggerGame.update();
-          froggerGame.draw();
-          if (froggerGame.isGameOver()) {
-            setState(STATE_GAME_OVER);
-          }
-          break;
-          
-        case GAME_HELICOPTER:
-          helicopterGame.update();
-          helicopterGame.draw();
-          if (helicopterGame.isGameOver()) {
-            setState(STATE_GAME_OVER);
-          }
-          break;
-          
-        case GAME_PACMAN:
-          pacmanGame.update();
-          pacmanGame.draw();
-          if (pacmanGame.isGameOver()) {
-            // Check if player won or lost
-            if (pacmanGame.isGameWon()) {
-              setState(STATE_GAME_WON);
-            } else {
-              setState(STATE_GAME_OVER);
-            }
-          }
+    case STATE_PLAYING: {
+      // UP and DOWN together suspend the game. One the save cannot hold
+      // keeps playing, resuming it would not restore its timers.
+      if ((buttons.upPressed && buttons.down) || (buttons.downPressed && buttons.up)) {
+        if (saveState.suspend()) {
+          setState(STATE_PAUSED);
           break;
+        }
+        LOG_WARN("Game %d not paused, its state was not saved", currentGame);
+      }
+      
+      PROFILE_SCOPE(PROFILE_UPDATE);
+      unsigned long frameStart = micros();
+      
+      // One call into whichever game is running, no switch over the games
+      const GameEntry* game = gameArena.getGame();
+      void* data = gameArena.getData();
+      game->update(data);
+      if (game->isGameOver(data)) {
+        setState(game->isGameWon(data) ? STATE_GAME_WON : STATE_GAME_OVER);
       }
+      
+      frameMicros += micros() - frameStart;
       break;
+    }
       
     case STATE_GAME_OVER:
       handleGameOverInput();
@@ -118,56 +99,88 @@ void GameManager::update() {
     case STATE_GAME_WON:
       handleGameWonInput();
       break;
+      
+    case STATE_PAUSED:
+      handlePausedInput();
+      break;
   }
 }
 
+void GameManager::render() {
+  // Menu and end screens are drawn when their input changes them
+  if (currentState != STATE_PLAYING) return;
+  
+  PROFILE_SCOPE(PROFILE_DRAW);
+  unsigned long frameStart = micros();
+  
+  const GameEntry* game = gameArena.getGame();
+  void* data = gameArena.getData();
+  if (frameChanged(game->getFrameVersion(data))) {
+    game->draw(data);
+#if DISPLAY_PAGED
+    // Too many draw calls for the display list, draw the frame page by page
+    if (display.listOverflowed()) display.displayInPages(game->draw, data);
+#endif
+  }
+  
+  frameMicros += micros() - frameStart;
+  frameCount++;
+}
+
 void GameManager::setState(GameState newState) {
   currentState = newState;
+  latencyTracker.setGame(newState == STATE_PLAYING ? currentGame : -1);
+#if ENABLE_PROFILER
+  profiler.setGame(newState == STATE_PLAYING ? currentGame : -1);
+#endif
   
   switch (newState) {
     case STATE_MENU:
+      saveState.discard();
       showMenu();
       break;
     case STATE_GAME_OVER:
+      saveState.discard();
+      reportDisplayStats();
       showGameOver();
       break;
     case STATE_GAME_WON:
+      saveState.discard();
+      reportDisplayStats();
       showGameWon();
       break;
+    case STATE_PAUSED:
+      showPaused();
+      break;
   }
 }
 
 void GameManager::setGame(int gameId) {
+  int index = GameRegistry::indexOf(gameId);
+  if (index < 0) return; // Left out of this build
+  
+  const GameEntry& game = GameRegistry::games[index];
   currentGame = gameId;
-  menuSelection = gameId;
+  menuSelection = index;
   
-  switch (gameId) {
-    case GAME_SNAKE:
-      snakeGame.init();
-      break;
-    case GAME_TETRIS:
-      tetrisGame.init();
-      break;
-    case GAME_FLAPPY:
-      flappyGame.init();
-      break;
-    case GAME_2048:
-      game2048.init();
-      break;
-    case GAME_BREAKOUT:
-      breakoutGame.init();
-      break;
-    case GAME_FROGGER:
-      froggerGame.init();
-      break;
-    case GAME_HELICOPTER:
-      helicopterGame.init();
-      break;
-    case GAME_PACMAN:
-      pacmanGame.init();
-      break;
-  }
+  // Only the selected game is resident, the previous one is destroyed
+  saveState.discard();
+  gameArena.start(game);
+  game.init(gameArena.getData());
   
+  display.resetFlushStats();
+  framePipeline.resetStats();
+  backgroundCache.resetStats();
+  inputQueue.resetStats();
+  frameScheduler.resetStats();
+  latencyTracker.resetStats(gameId);
+#if ENABLE_PROFILER
+  profiler.resetStats(gameId);
+#endif
+  frameMicros = 0;
+  frameCount = 0;
+  framesSkipped = 0;
+  forceDraw = true;
   setState(STATE_PLAYING);
 }
 
@@ -175,22 +188,21 @@ void GameManager::showMenu() {
   clearDisplay();
   
   //drawCenteredText("GAMES", 5, 2);
-  display.drawBitmap(0, 0, epd_bitmap_gameheader, 128, 20, 1);
+  display.drawAsset(assetGameHeader, 0, 0);
 
   
   display.setTextSize(1);
   
   // Calculate which items to show
   int startItem = menuScroll;
-  int endItem = min(startItem + VISIBLE_MENU_ITEMS, MAX_GAMES);
   
-  for (int i = 0; i < VISIBLE_MENU_ITEMS && (startItem + i) < MAX_GAMES; i++) {
+  for (int i = 0; i < VISIBLE_MENU_ITEMS && (startItem + i) < GameRegistry::count; i++) {
     int gameIndex = startItem + i;
     int y = 25 + i * 12;
     
     if (menuSelection == gameIndex) {
       //display.fillRect(5, y - 2, SCREEN_WIDTH - 10, 10, SSD1306_WHITE);
-      display.drawBitmap(0, y - 2, epd_bitmap_Select, 128, 10, SSD1306_WHITE);
+      display.drawAsset(assetSelect, 0, y - 2);
       display.setTextColor(SSD1306_BLACK);
     } else {
       display.setTextColor(SSD1306_WHITE);
@@ -198,13 +210,13 @@ void GameManager::showMenu() {
     
     // Game name
     display.setCursor(10, y);
-    display.print(gameNames[gameIndex]);
+    display.print(GameRegistry::games[gameIndex].name);
     
     // Highscore
-    int highscore = getGameHighscore(gameIndex);
+    int highscore = getGameHighscore(GameRegistry::games[gameIndex].id);
     if (highscore > 0) {
       display.setCursor(SCREEN_WIDTH - 35, y);
-      display.print(highscore);
+      display.printNumber(highscore);
     }
   }
   
@@ -216,7 +228,7 @@ void GameManager::showMenu() {
     display.print(F("^"));
   }
   
-  if (menuScroll + VISIBLE_MENU_ITEMS < MAX_GAMES) {
+  if (menuScroll + VISIBLE_MENU_ITEMS < GameRegistry::count) {
     // Down arrow
     display.setCursor(SCREEN_WIDTH - 10, 55);
     display.setTextColor(SSD1306_WHITE);
@@ -227,13 +239,13 @@ void GameManager::showMenu() {
 }
 
 void GameManager::handleMenuInput() {
-  if (buttons.upPressed) {
-    menuSelection = (menuSelection - 1 + MAX_GAMES) % MAX_GAMES;
+  if (buttons.upRepeat) {
+    menuSelection = (menuSelection - 1 + GameRegistry::count) % GameRegistry::count;
     
     // Adjust scroll for wrap-around
-    if (menuSelection == MAX_GAMES - 1) {
+    if (menuSelection == GameRegistry::count - 1) {
       // Wrapped from first to last - scroll to show last items
-      menuScroll = MAX_GAMES - VISIBLE_MENU_ITEMS;
+      menuScroll = max(GameRegistry::count - VISIBLE_MENU_ITEMS, 0);
     } else if (menuSelection < menuScroll) {
       // Normal upward scroll
       menuScroll = menuSelection;
@@ -241,8 +253,8 @@ void GameManager::handleMenuInput() {
     
     showMenu();
   }
-  else if (buttons.downPressed) {
-    menuSelection = (menuSelection + 1) % MAX_GAMES;
+  else if (buttons.downRepeat) {
+    menuSelection = (menuSelection + 1) % GameRegistry::count;
     
     // Adjust scroll for wrap-around
     if (menuSelection == 0) {
@@ -256,27 +268,17 @@ void GameManager::handleMenuInput() {
     showMenu();
   }
   else if (buttons.rightPressed) {
-    setGame(menuSelection);
+    setGame(GameRegistry::games[menuSelection].id);
   }
 }
 
 void GameManager::showGameOver() {
   clearDisplay();
   
-  drawCenteredText("GAME OVER", 0, 2);
+  drawCenteredText(gameOverTitle, 0);
   
   // Get score and check for highscore
-  int score = 0;
-  switch (currentGame) {
-    case GAME_SNAKE: score = snakeGame.getScore(); break;
-    case GAME_TETRIS: score = tetrisGame.getScore(); break;
-    case GAME_FLAPPY: score = flappyGame.getScore(); break;
-    case GAME_2048: score = game2048.getScore(); break;
-    case GAME_BREAKOUT: score = breakoutGame.getScore(); break;
-    case GAME_FROGGER: score = froggerGame.getScore(); break;
-    case GAME_HELICOPTER: score = helicopterGame.getScore(); break;
-    case GAME_PACMAN: score = pacmanGame.getScore(); break;
-  }
+  int score = gameArena.getGame()->getScore(gameArena.getData());
   
   // Check and save highscore
   newHighscore = checkNewHighscore(currentGame, score);
@@ -297,11 +299,11 @@ void GameManager::showGameOver() {
   
   // Show NEW HIGHSCORE message
   if (newHighscore) {
-    drawCenteredText("NEW HIGHSCORE!", 37, 1);
+    drawCenteredText(newHighscoreText, 37);
   }
   
-  drawCenteredText("UP: Menu", 47, 1);
-  drawCenteredText("RIGHT: Restart", 57, 1);
+  drawCenteredText(menuHint, 47);
+  drawCenteredText(restartHint, 57);
   
   updateDisplay();
 }
@@ -309,20 +311,10 @@ void GameManager::showGameOver() {
 void GameManager::showGameWon() {
   clearDisplay();
   
-  drawCenteredText("YOU WON!", 0, 2);
+  drawCenteredText(gameWonTitle, 0);
   
   // Get score and check for highscore
-  int score = 0;
-  switch (currentGame) {
-    case GAME_SNAKE: score = snakeGame.getScore(); break;
-    case GAME_TETRIS: score = tetrisGame.getScore(); break;
-    case GAME_FLAPPY: score = flappyGame.getScore(); break;
-    case GAME_2048: score = game2048.getScore(); break;
-    case GAME_BREAKOUT: score = breakoutGame.getScore(); break;
-    case GAME_FROGGER: score = froggerGame.getScore(); break;
-    case GAME_HELICOPTER: score = helicopterGame.getScore(); break;
-    case GAME_PACMAN: score = pacmanGame.getScore(); break;
-  }
+  int score = gameArena.getGame()->getScore(gameArena.getData());
   
   // Check and save highscore
   newHighscore = checkNewHighscore(currentGame, score);
@@ -343,15 +335,134 @@ void GameManager::showGameWon() {
   
   // Show NEW HIGHSCORE message
   if (newHighscore) {
-    drawCenteredText("NEW HIGHSCORE!", 37, 1);
+    drawCenteredText(newHighscoreText, 37);
   }
   
-  drawCenteredText("UP: Menu", 47, 1);
-  drawCenteredText("RIGHT: Play Again", 57, 1);
+  drawCenteredText(menuHint, 47);
+  drawCenteredText(playAgainHint, 57);
+  
+  updateDisplay();
+}
+
+void GameManager::showPaused() {
+  clearDisplay();
+  
+  drawCenteredText(pausedTitle, 10);
+  drawCenteredText(GameRegistry::games[menuSelection].name, 27, 1);
+  drawCenteredText(resumeHint, 47);
+  drawCenteredText(menuHint, 57);
   
   updateDisplay();
 }
 
+bool GameManager::frameChanged(unsigned long version) {
+#if HEADLESS
+  // Nothing is shown, only the game logic runs
+  framesSkipped++;
+  return false;
+#else
+#if SKIP_UNCHANGED_FRAMES
+  // Nothing moved since the last draw, the panel already shows this frame
+  if (!forceDraw && version == drawnVersion) {
+    framesSkipped++;
+    return false;
+  }
+#endif
+  
+  drawnVersion = version;
+  forceDraw = false;
+  return true;
+#endif
+}
+
+void GameManager::reportDisplayStats() {
+  unsigned long frames = display.getFlushCount();
+  if (frames == 0) return;
+  
+  // I2C traffic of the game that just ended
+  Serial.print(gameArena.getGame()->name);
+  Serial.print(F(": "));
+  Serial.print(display.getTotalFlushBytes() / frames);
+  Serial.print(F(" bytes/frame over "));
+  Serial.print(frames);
+  Serial.println(F(" frames"));
+  
+  if (frameCount > 0) {
+    Serial.print(F("Update and draw: "));
+    Serial.print(frameMicros / frameCount);
+    Serial.println(F(" us/frame"));
+    
+    Serial.print(F("Skipped "));
+    Serial.print(framesSkipped);
+    Serial.print(F(" of "));
+    Serial.print(frameCount);
+    Serial.print(F(" frames ("));
+    Serial.print(framesSkipped * 100 / frameCount);
+    Serial.println(F("%)"));
+  }
+  
+  if (backgroundCache.getHits() + backgroundCache.getMisses() > 0 && frameCount > 0) {
+    Serial.print(F("Background cache: "));
+    Serial.print(backgroundCache.getHits());
+    Serial.print(F(" hits, "));
+    Serial.print(backgroundCache.getMisses());
+    Serial.print(F(" misses, saved "));
+    Serial.print(backgroundCache.getSavedMicros() / (long)frameCount);
+    Serial.println(F(" us/frame"));
+  }
+  
+  if (framePipeline.isRunning()) {
+    Serial.print(F("Frames produced: "));
+    Serial.print(framePipeline.getFramesProduced());
+    Serial.print(F(", flushed: "));
+    Serial.println(framePipeline.getFramesFlushed());
+  }
+  
+  Serial.print(F("Ticks: "));
+  Serial.print(frameScheduler.getTicks());
+  Serial.print(F(" in "));
+  Serial.print(frameScheduler.getFrames());
+  Serial.print(F(" frames, caught up "));
+  Serial.print(frameScheduler.getCatchUpTicks());
+  Serial.print(F(", dropped "));
+  Serial.print(frameScheduler.getDroppedTicks());
+  Serial.print(F(", overruns "));
+  Serial.println(frameScheduler.getOverruns());
+  
+  Serial.print(F("Frame start late: "));
+  Serial.print(frameScheduler.getMeanLateness());
+  Serial.print(F(" us mean, "));
+  Serial.print(frameScheduler.getMaxLateness());
+  Serial.println(F(" us max"));
+  
+  Serial.print(F("Input edges: "));
+  Serial.print(inputQueue.getPushed());
+  Serial.print(F(", dropped: "));
+  Serial.println(inputQueue.getDropped());
+  
+#if TRACK_INPUT_LATENCY
+  latencyTracker.printStats(currentGame);
+#endif
+  
+#if ENABLE_PROFILER
+  profiler.printStats(currentGame);
+  profiler.dump(currentGame);
+#endif
+  
+#if RECORD_INPUT
+  inputReplay.print();
+#endif
+  
+#if DISPLAY_PAGED
+  Serial.print(F("List overflows: "));
+  Serial.print(display.getListOverflows());
+  Serial.print(F(", page passes: "));
+  Serial.print(display.getPagePasses());
+  Serial.print(F(", page mismatches: "));
+  Serial.println(display.getVerifyMismatches());
+#endif
+}
+
 void GameManager::handleGameOverInput() {
   if (buttons.upPressed) {
     setState(STATE_MENU);
@@ -368,4 +479,20 @@ void GameManager::handleGameWonInput() {
   else if (buttons.rightPressed) {
     setGame(currentGame);
   }
+}
+
+void GameManager::handlePausedInput() {
+  if (buttons.upPressed) {
+    setState(STATE_MENU);
+  }
+  else if (buttons.rightPressed) {
+    // Loaded back from the save, so the game's timers carry on from the
+    // pause. A game the save did not take goes on from RAM.
+    if (saveState.resume() || gameArena.getGame()) {
+      forceDraw = true;
+      setState(STATE_PLAYING);
+    } else {
+      setState(STATE_MENU);
+    }
+  }
 }
\ No newline at end of file
@@ -2,14 +2,7 @@
 #define GAMEMANAGER_H
 
 #include "config.h"
-#include "snake.h"
-#include "tetris.h"
-#include "flappy.h"
-#include "game2048.h"
-#include "breakout.h"
-#include "frogger.h"
-#include "helicopter.h"
-#include "pacman.h"
+#include "gamearena.h"
 #include "highscore.h"
 
 class GameManager {
@@ -18,21 +11,31 @@ private:
   int currentGame;
   int menuSelection;
   int menuScroll; // For scrolling menu
-  const char* gameNames[MAX_GAMES] = {"SNAKE", "TETRIS", "FLAPPY BIRD", "2048", "BREAKOUT", "FROGGER", "HELICOPTER", "PAC-MAN"};
   static const int VISIBLE_MENU_ITEMS = 3;
   bool newHighscore; // Flag for new highscore
+  unsigned long frameMicros; // Time spent in update and draw this game
+  unsigned long frameCount;  // Frames rendered while playing
+  unsigned long framesSkipped; // Loops where the game state did not change
+  unsigned long drawnVersion;  // Frame version of the game at its last draw
+  bool forceDraw;
+  
+  bool frameChanged(unsigned long version);
+  void reportDisplayStats();
   
 public:
   void init();
   void update();
+  void render();
   void setState(GameState newState);
   void setGame(int gameId);
   void showMenu();
   void handleMenuInput();
   void showGameOver();
   void showGameWon();
+  void showPaused();
   void handleGameOverInput();
   void handleGameWonInput();
+  void handlePausedInput();
   int getCurrentGame() { return currentGame; }
   GameState getState() { return currentState; }
 };
@@ -41,5 +44,6 @@ extern GameManager gameManager;
 
 void initGameManager();
 void updateGameManager();
+void renderGameManager();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include "gameregistry.h"
+
+constexpr GameEntry GameRegistry::games[];
+constexpr int GameRegistry::count;
+
+int GameRegistry::indexOf(int gameId) {
+  for (int i = 0; i < count; i++) {
+    if (games[i].id == gameId) return i;
+  }
+  return -1;
+}
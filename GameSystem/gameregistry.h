@@ -0,0 +1,114 @@
+#ifndef GAMEREGISTRY_H
+#define GAMEREGISTRY_H
+
+#include "config.h"
+#include <new>
+#include "snake.h"
+#include "tetris.h"
+#include "flappy.h"
+#include "game2048.h"
+#include "breakout.h"
+#include "frogger.h"
+#include "helicopter.h"
+#include "pacman.h"
+
+// What GameManager calls on a game, as plain functions taking the game's
+// bytes in the arena, so a frame costs one indirect call instead of a
+// switch over every game
+struct GameEntry {
+  GameID id;
+  const char* name;
+  size_t size;
+  size_t align;
+  void (*construct)(void* game);
+  void (*destroy)(void* game);
+  void (*init)(void* game);
+  void (*update)(void* game);
+  void (*draw)(void* game);
+  bool (*isGameOver)(void* game);
+  bool (*isGameWon)(void* game);
+  int (*getScore)(void* game);
+  // Changes whenever the next frame would look different from the last one
+  // drawn; GameManager skips draw() while it stays the same
+  unsigned long (*getFrameVersion)(void* game);
+  void (*serialize)(void* game, SaveStream& state);
+};
+
+// The entry functions of one game class
+template <typename Game>
+struct GameOps {
+  // Value initialized, so the game starts zeroed like a global would
+  static void construct(void* game) { new (game) Game(); }
+  static void destroy(void* game) { static_cast<Game*>(game)->~Game(); }
+  static void init(void* game) { static_cast<Game*>(game)->init(); }
+  static void update(void* game) { static_cast<Game*>(game)->update(); }
+  static void draw(void* game) { static_cast<Game*>(game)->draw(); }
+  static bool isGameOver(void* game) { return static_cast<Game*>(game)->isGameOver(); }
+  static bool isGameWon(void* game) { return static_cast<Game*>(game)->isGameWon(); }
+  static int getScore(void* game) { return static_cast<Game*>(game)->getScore(); }
+  static unsigned long getFrameVersion(void* game) { return static_cast<Game*>(game)->getFrameVersion(); }
+  static void serialize(void* game, SaveStream& state) { static_cast<Game*>(game)->serialize(state); }
+};
+
+template <typename Game>
+constexpr GameEntry gameEntry(GameID id, const char* name) {
+  return {id, name, sizeof(Game), alignof(Game),
+          &GameOps<Game>::construct, &GameOps<Game>::destroy, &GameOps<Game>::init,
+          &GameOps<Game>::update, &GameOps<Game>::draw, &GameOps<Game>::isGameOver,
+          &GameOps<Game>::isGameWon, &GameOps<Game>::getScore, &GameOps<Game>::getFrameVersion,
+          &GameOps<Game>::serialize};
+}
+
+// The games built in, in menu order. Adding a game is one entry here and
+// its ENABLE_GAME_ flag; games left out are never referenced, so the linker
+// drops their code.
+struct GameRegistry {
+  static constexpr GameEntry games[] = {
+#if ENABLE_GAME_SNAKE
+    gameEntry<SnakeGame>(GAME_SNAKE, "SNAKE"),
+#endif
+#if ENABLE_GAME_TETRIS
+    gameEntry<TetrisGame>(GAME_TETRIS, "TETRIS"),
+#endif
+#if ENABLE_GAME_FLAPPY
+    gameEntry<FlappyGame>(GAME_FLAPPY, "FLAPPY BIRD"),
+#endif
+#if ENABLE_GAME_2048
+    gameEntry<Game2048>(GAME_2048, "2048"),
+#endif
+#if ENABLE_GAME_BREAKOUT
+    gameEntry<BreakoutGame>(GAME_BREAKOUT, "BREAKOUT"),
+#endif
+#if ENABLE_GAME_FROGGER
+    gameEntry<FroggerGame>(GAME_FROGGER, "FROGGER"),
+#endif
+#if ENABLE_GAME_HELICOPTER
+    gameEntry<HelicopterGame>(GAME_HELICOPTER, "HELICOPTER"),
+#endif
+#if ENABLE_GAME_PACMAN
+    gameEntry<PacManGame>(GAME_PACMAN, "PAC-MAN"),
+#endif
+  };
+  static constexpr int count = sizeof(games) / sizeof(games[0]);
+  
+  static int indexOf(int gameId);
+};
+
+constexpr size_t largerOf(size_t a, size_t b) {
+  return (a > b) ? a : b;
+}
+
+// Largest size, alignment and the sum of all sizes of the registered games
+constexpr size_t largestGameSize(int from = 0) {
+  return (from == GameRegistry::count) ? 1 : largerOf(GameRegistry::games[from].size, largestGameSize(from + 1));
+}
+
+constexpr size_t largestGameAlign(int from = 0) {
+  return (from == GameRegistry::count) ? 1 : largerOf(GameRegistry::games[from].align, largestGameAlign(from + 1));
+}
+
+constexpr size_t totalGameSize(int from = 0) {
+  return (from == GameRegistry::count) ? 0 : GameRegistry::games[from].size + totalGameSize(from + 1);
+}
+
+#endif
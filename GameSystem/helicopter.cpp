@@ -1,52 +1,65 @@
 #include "helicopter.h"
 #include "display.h"
 #include "input.h"
-
-HelicopterGame helicopterGame;
+#include "frameclock.h"
+#include "replay.h"
+#include "scrolllayer.h"
 
 void HelicopterGame::init() {
-  heli.y = SCREEN_HEIGHT / 2;
-  heli.velocity = 0;
+  heli.place(HELI_X, SCREEN_HEIGHT / 2);
+  heli.velX = 0;
+  heli.velY = 0;
   
   score = 0;
   gameOver = false;
-  lastUpdate = millis();
-  gameSpeed = 1.5;
-  gravity = 0.15;
-  lift = -1.0;
+  frameVersion = 0;
+  physics.begin(HELI_STEP_MS, frameClock.now());
+  gameSpeed = Fixed::fromFloat(1.5);
+  gravity = Fixed::fromFloat(0.15);
+  lift = -1;
   caveOffset = 0;
+  caveShift = 0;
+  renderedShift = 0;
   
   generateCave();
+  scrollLayer.reset();
 }
 
 void HelicopterGame::update() {
+  // The cave scrolls in whole steps, so the frame only changes on a step
+  // and the helicopter is drawn where the step left it
+  uint8_t steps = physics.advance(frameClock.now());
+  for (uint8_t i = 0; i < steps && !gameOver; i++) {
+    step();
+    frameVersion++;
+  }
+}
+
+void HelicopterGame::step() {
+  // Lift is held per step, not per update
   handleInput();
+  updateHelicopter();
+  updateCave();
   
-  unsigned long currentTime = millis();
+  if (checkCollisions()) {
+    gameOver = true;
+  }
   
-  if (currentTime - lastUpdate > 30) { // ~33 FPS
-    updateHelicopter();
-    updateCave();
-    
-    if (checkCollisions()) {
-      gameOver = true;
-    }
-    
-    score++;
-    
-    // Gradually increase difficulty
-    if (score % 500 == 0 && gameSpeed < 3.0) {
-      gameSpeed += 0.2;
-    }
-    
-    lastUpdate = currentTime;
+  score++;
+  
+  // Gradually increase difficulty
+  if (score % 500 == 0 && gameSpeed < 3) {
+    gameSpeed += Fixed::fromFloat(0.2);
   }
 }
 
 void HelicopterGame::draw() {
+#if SCROLL_LAYER_ENABLED
+  drawCaveLayer(); // Replaces the whole frame
+#else
   clearDisplay();
-  
   drawCave();
+#endif
   drawHelicopter();
   drawUI();
   
@@ -55,7 +68,7 @@ void HelicopterGame::draw() {
 
 void HelicopterGame::handleInput() {
   if (buttons.up || buttons.right) {
-    heli.velocity = lift;
+    heli.velY = lift;
   }
 }
 
@@ -64,10 +77,10 @@ void HelicopterGame::generateCave() {
   int currentTop = 15;
   
   for (int i = 0; i < CAVE_SEGMENTS; i++) {
-    cave[i].gapHeight = currentGap + random(-3, 4);
+    cave[i].gapHeight = currentGap + gameRandom(-3, 4);
     cave[i].gapHeight = constrain(cave[i].gapHeight, 18, 35);
     
-    cave[i].topHeight = currentTop + random(-2, 3);
+    cave[i].topHeight = currentTop + gameRandom(-2, 3);
     cave[i].topHeight = constrain(cave[i].topHeight, 5, SCREEN_HEIGHT - cave[i].gapHeight - 5);
     
     cave[i].bottomHeight = SCREEN_HEIGHT - cave[i].topHeight - cave[i].gapHeight;
@@ -78,17 +91,16 @@ void HelicopterGame::generateCave() {
 }
 
 void HelicopterGame::updateHelicopter() {
-  heli.velocity += gravity;
-  heli.y += heli.velocity;
+  heli.step(0, gravity);
   
   // Keep helicopter on screen
   if (heli.y < 0) {
     heli.y = 0;
-    heli.velocity = 0;
+    heli.velY = 0;
   }
   if (heli.y > SCREEN_HEIGHT - HELI_SIZE) {
     heli.y = SCREEN_HEIGHT - HELI_SIZE;
-    heli.velocity = 0;
+    heli.velY = 0;
   }
 }
 
@@ -97,7 +109,8 @@ void HelicopterGame::updateCave() {
   
   // When we've scrolled one segment width, shift the cave
   if (caveOffset >= 4) {
-    caveOffset = 0;
+    caveOffset -= 4;
+    caveShift++;
     
     // Shift all segments left
     for (int i = 0; i < CAVE_SEGMENTS - 1; i++) {
@@ -106,10 +119,10 @@ void HelicopterGame::updateCave() {
     
     // Generate new segment at the end
     int lastIndex = CAVE_SEGMENTS - 1;
-    cave[lastIndex].gapHeight = cave[lastIndex - 1].gapHeight + random(-3, 4);
+    cave[lastIndex].gapHeight = cave[lastIndex - 1].gapHeight + gameRandom(-3, 4);
     cave[lastIndex].gapHeight = constrain(cave[lastIndex].gapHeight, 18, 35);
     
-    cave[lastIndex].topHeight = cave[lastIndex - 1].topHeight + random(-2, 3);
+    cave[lastIndex].topHeight = cave[lastIndex - 1].topHeight + gameRandom(-2, 3);
     cave[lastIndex].topHeight = constrain(cave[lastIndex].topHeight, 5, 
                                          SCREEN_HEIGHT - cave[lastIndex].gapHeight - 5);
     
@@ -136,19 +149,21 @@ bool HelicopterGame::checkCollisions() {
 }
 
 void HelicopterGame::drawHelicopter() {
+  int y = heli.y.toInt();
+  
   // Draw helicopter body
-  display.fillRect(HELI_X, heli.y, HELI_SIZE, HELI_SIZE, SSD1306_WHITE);
+  display.fillRect(HELI_X, y, HELI_SIZE, HELI_SIZE, SSD1306_WHITE);
   
   // Draw rotor
-  display.drawLine(HELI_X - 1, heli.y - 1, HELI_X + HELI_SIZE + 1, heli.y - 1, SSD1306_WHITE);
+  display.drawLine(HELI_X - 1, y - 1, HELI_X + HELI_SIZE + 1, y - 1, SSD1306_WHITE);
   
   // Draw tail
-  display.drawPixel(HELI_X + HELI_SIZE, heli.y + 2, SSD1306_WHITE);
+  display.drawPixel(HELI_X + HELI_SIZE, y + 2, SSD1306_WHITE);
 }
 
 void HelicopterGame::drawCave() {
   for (int i = 0; i < CAVE_SEGMENTS; i++) {
-    int x = i * 4 - caveOffset;
+    int x = i * 4 - caveOffset.toInt();
     
     if (x >= -4 && x < SCREEN_WIDTH) {
       // Draw top wall
@@ -161,11 +176,55 @@ void HelicopterGame::drawCave() {
   }
 }
 
+void HelicopterGame::drawCaveLayer() {
+  scrollLayer.scrollTo(caveShift * 4 + caveOffset.toInt());
+  
+  // New segments can land on columns that were already shown empty
+  while (renderedShift < caveShift) {
+    renderedShift++;
+    long x = (renderedShift + CAVE_SEGMENTS - 1) * 4;
+    scrollLayer.markDirty(x, x + 3);
+  }
+  
+  if (scrollLayer.beginRender()) {
+    // Clipped to the columns that need drawing
+    for (int i = 0; i < CAVE_SEGMENTS; i++) {
+      long x = (caveShift + i) * 4;
+      scrollLayer.fillRect(x, 0, 4, cave[i].topHeight, SSD1306_WHITE);
+      
+      int bottomY = cave[i].topHeight + cave[i].gapHeight;
+      scrollLayer.fillRect(x, bottomY, 4, cave[i].bottomHeight, SSD1306_WHITE);
+    }
+  }
+  
+  scrollLayer.blit(display.getBuffer(), false);
+}
+
 void HelicopterGame::drawUI() {
   display.setTextSize(1);
   display.setTextColor(SSD1306_WHITE);
   
   // Score (top right to avoid cave)
   display.setCursor(SCREEN_WIDTH - 30, 0);
-  display.print(score / 10); // Divide by 10 for reasonable scoring
-}
\ No newline at end of file
+  display.printNumber(score / 10); // Divide by 10 for reasonable scoring
+}
+
+void HelicopterGame::serialize(SaveStream& state) {
+  heli.serialize(state);
+  for (int i = 0; i < CAVE_SEGMENTS; i++) {
+    state.value(cave[i].topHeight);
+    state.value(cave[i].bottomHeight);
+    state.value(cave[i].gapHeight);
+  }
+  state.value(score);
+  state.value(gameOver);
+  physics.serialize(state);
+  state.value(gameSpeed);
+  state.value(gravity);
+  state.value(lift);
+  state.value(caveOffset);
+  state.value(caveShift);
+  
+  // init() emptied the scroll layer, the whole cave is drawn again
+  if (state.isLoading()) renderedShift = caveShift;
+}
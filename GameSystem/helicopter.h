@@ -2,15 +2,12 @@
 #define HELICOPTER_H
 
 #include "config.h"
+#include "physics.h"
 
 #define HELI_SIZE 4
 #define CAVE_SEGMENTS 32
 #define HELI_X 15
-
-struct Helicopter {
-  float y;
-  float velocity;
-};
+#define HELI_STEP_MS 32 // Two ticks, the rate the old 30 ms check gave
 
 struct CaveSegment {
   int topHeight;
@@ -20,22 +17,27 @@ struct CaveSegment {
 
 class HelicopterGame {
 private:
-  Helicopter heli;
+  Body heli;
   CaveSegment cave[CAVE_SEGMENTS];
   int score;
   bool gameOver;
-  unsigned long lastUpdate;
-  float gameSpeed;
-  float gravity;
-  float lift;
-  int caveOffset;
+  unsigned long frameVersion;
+  PhysicsClock physics;
+  Fixed gameSpeed;
+  Fixed gravity;
+  Fixed lift;
+  Fixed caveOffset;  // Sub-pixels scrolled into the first segment
+  long caveShift;    // Segments scrolled off since init
+  long renderedShift;
   
+  void step();
   void generateCave();
   void updateHelicopter();
   void updateCave();
   bool checkCollisions();
   void drawHelicopter();
   void drawCave();
+  void drawCaveLayer();
   void drawUI();
   
 public:
@@ -43,11 +45,13 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  bool isGameWon() { return false; }
+  unsigned long getFrameVersion() { return frameVersion; }
   int getScore() { return score; }
   const char* getName() { return "HELICOPTER"; }
+  const Body& getHeli() { return heli; }
 };
 
-extern HelicopterGame helicopterGame;
-
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "highscore.h"
+#include "logger.h"
 
 HighscoreManager highscoreManager;
 
@@ -19,16 +20,16 @@ void saveGameHighscore(int gameId, int score) {
 }
 
 void HighscoreManager::init() {
+  // Boot loads them once, later calls find them ready
+  if (initialized) return;
+  
   EEPROM.begin(EEPROM_SIZE);
   loadFromEEPROM();
   initialized = true;
   
-  Serial.println("Highscore system initialized");
+  LOG_INFO("Highscore system initialized");
   for (int i = 0; i < MAX_GAMES; i++) {
-    Serial.print("Game ");
-    Serial.print(i);
-    Serial.print(" highscore: ");
-    Serial.println(data.scores[i]);
+    LOG_INFO("Game %d highscore: %d", i, data.scores[i]);
   }
 }
 
@@ -39,19 +40,15 @@ void HighscoreManager::loadFromEEPROM() {
   // Read data from EEPROM
   EEPROM.get(HIGHSCORE_BASE_ADDR, data);
   
-  // Debug: Print loaded data
-  Serial.print("Loaded magic: 0x");
-  Serial.println(data.magic, HEX);
-  Serial.print("Loaded checksum: ");
-  Serial.println(data.checksum);
+  LOG_DEBUG("Loaded magic: 0x%X checksum: %u", data.magic, data.checksum);
   
   // Verify data integrity
   if (!isValidData()) {
-    Serial.println("Invalid EEPROM data, resetting highscores");
+    LOG_WARN("Invalid EEPROM data, resetting highscores");
     resetToDefaults();
     saveToEEPROM();
   } else {
-    Serial.println("Highscores loaded from EEPROM");
+    LOG_INFO("Highscores loaded from EEPROM");
   }
 }
 
@@ -62,16 +59,13 @@ void HighscoreManager::saveToEEPROM() {
   EEPROM.put(HIGHSCORE_BASE_ADDR, data);
   EEPROM.commit();
   
-  Serial.println("Highscores saved to EEPROM");
+  LOG_INFO("Highscores saved to EEPROM");
 }
 
 bool HighscoreManager::isValidData() {
   // Check magic number
   if (data.magic != HIGHSCORE_MAGIC) {
-    Serial.print("Magic mismatch: expected 0x");
-    Serial.print(HIGHSCORE_MAGIC, HEX);
-    Serial.print(", got 0x");
-    Serial.println(data.magic, HEX);
+    LOG_WARN("Magic mismatch: expected 0x%X, got 0x%X", HIGHSCORE_MAGIC, data.magic);
     return false;
   }
   
@@ -79,23 +73,17 @@ bool HighscoreManager::isValidData() {
   uint16_t savedChecksum = data.checksum;
   uint16_t calculatedChecksum = calculateChecksum();
   
-  Serial.print("Checksum - saved: ");
-  Serial.print(savedChecksum);
-  Serial.print(", calculated: ");
-  Serial.println(calculatedChecksum);
+  LOG_DEBUG("Checksum - saved: %u, calculated: %u", savedChecksum, calculatedChecksum);
   
   if (savedChecksum != calculatedChecksum) {
-    Serial.println("Checksum mismatch!");
+    LOG_WARN("Checksum mismatch!");
     return false;
   }
   
   // Check if scores are reasonable (not negative, not too high)
   for (int i = 0; i < MAX_GAMES; i++) {
     if (data.scores[i] < 0 || data.scores[i] > 999999) {
-      Serial.print("Invalid score for game ");
-      Serial.print(i);
-      Serial.print(": ");
-      Serial.println(data.scores[i]);
+      LOG_WARN("Invalid score for game %d: %d", i, data.scores[i]);
       return false;
     }
   }
@@ -150,15 +138,12 @@ void HighscoreManager::saveHighscore(int gameId, int score) {
     data.scores[gameId] = score;
     saveToEEPROM();
     
-    Serial.print("New highscore for game ");
-    Serial.print(gameId);
-    Serial.print(": ");
-    Serial.println(score);
+    LOG_INFO("New highscore for game %d: %d", gameId, score);
   }
 }
 
 void HighscoreManager::resetAllHighscores() {
   resetToDefaults();
   saveToEEPROM();
-  Serial.println("All highscores reset");
+  LOG_INFO("All highscores reset");
 }
\ No newline at end of file
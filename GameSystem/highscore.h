@@ -24,6 +24,7 @@ private:
   void resetToDefaults();
   
 public:
+  HighscoreManager() : initialized(false) {}
   void init();
   void saveHighscore(int gameId, int score);
   int getHighscore(int gameId);
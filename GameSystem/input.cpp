@@ -1,53 +1,285 @@
 #include "input.h"
+#include "latency.h"
+#include "replay.h"
+#include "frameclock.h"
+#include "profiler.h"
 
+#if INPUT_REGISTER_SAMPLING
+#include <soc/gpio_reg.h>
+#endif
+
+#if (INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE - 1)) != 0
+#error "INPUT_QUEUE_SIZE must be a power of two"
+#endif
+
+ButtonMasks buttonMasks;
 ButtonState buttons;
 unsigned long lastButtonTime = 0;
-ButtonState lastButtons;
+InputQueue inputQueue;
+
+// Not const so the interrupt handler finds it in RAM
+static uint8_t buttonPins[BUTTON_COUNT] = {
+  PIN_BUTTON_UP, PIN_BUTTON_DOWN, PIN_BUTTON_LEFT, PIN_BUTTON_RIGHT
+};
+#define DEBOUNCE_MICROS (BUTTON_DEBOUNCE * 1000UL)
+
+// Debounce and repeat state, one bit or entry per button. An edge is taken
+// as soon as it arrives and the edges in the BUTTON_DEBOUNCE window after
+// it are bounce; if the button ends the window at the other level that
+// counts as an edge at the end of the window.
+static uint8_t levelMask;     // Debounced levels
+static uint8_t rawMask;       // Level of the last edge seen, bounce included
+static uint8_t pressedMask;   // Pressed since the last update
+static uint8_t releasedMask;  // Released since the last update
+static unsigned long edgeTime[BUTTON_COUNT];    // When the debounced level last changed
+static unsigned long nextRepeat[BUTTON_COUNT];  // When a held button repeats next
+static unsigned long droppedSeen = 0;
+
+bool IRAM_ATTR InputQueue::push(uint8_t button, bool pressed, unsigned long time) {
+  uint32_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) >= INPUT_QUEUE_SIZE) {
+    dropped++;
+    return false;
+  }
+  
+  InputEvent& event = events[h & (INPUT_QUEUE_SIZE - 1)];
+  event.time = time;
+  event.button = button;
+  event.pressed = pressed;
+  head.store(h + 1, std::memory_order_release);
+  pushed++;
+  return true;
+}
+
+bool InputQueue::peek(InputEvent& event) {
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  if (t == head.load(std::memory_order_acquire)) return false;
+  event = events[t & (INPUT_QUEUE_SIZE - 1)];
+  return true;
+}
+
+void InputQueue::resetStats() {
+  pushedBase = pushed;
+  droppedBase = dropped;
+}
+
+bool injectInputEvent(uint8_t button, bool pressed, unsigned long time) {
+  if (button >= BUTTON_COUNT) return false;
+  return inputQueue.push(button, pressed, time);
+}
+
+uint8_t IRAM_ATTR sampleButtons() {
+#if INPUT_REGISTER_SAMPLING
+  // Inverted because of INPUT_PULLUP
+  uint32_t low = ~REG_READ(GPIO_IN_REG);
+  return ((low >> PIN_BUTTON_UP) & 1) << BUTTON_UP |
+         ((low >> PIN_BUTTON_DOWN) & 1) << BUTTON_DOWN |
+         ((low >> PIN_BUTTON_LEFT) & 1) << BUTTON_LEFT |
+         ((low >> PIN_BUTTON_RIGHT) & 1) << BUTTON_RIGHT;
+#else
+  uint8_t sample = 0;
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (digitalRead(buttonPins[i]) == LOW) sample |= BUTTON_BIT(i);
+  }
+  return sample;
+#endif
+}
+
+#if INPUT_INTERRUPTS_ENABLED
+static void IRAM_ATTR buttonInterrupt(void* arg) {
+  uint8_t button = (uint8_t)(uintptr_t)arg;
+  inputQueue.push(button, (sampleButtons() >> button) & 1, micros());
+}
+#else
+static uint8_t polledMask;
+
+static void pollButtons() {
+  // Without interrupts the edges are found once per update as before
+  uint8_t sample = sampleButtons();
+  uint8_t changed = sample ^ polledMask;
+  polledMask = sample;
+  
+  for (uint8_t i = 0; changed; i++, changed >>= 1) {
+    if (changed & 1) inputQueue.push(i, (sample >> i) & 1, micros());
+  }
+}
+#endif
+
+// Moves the debounced level. Returns false when this is a second press
+// since the last update, which has to wait for the next one.
+static bool applyEdge(uint8_t button, bool pressed, unsigned long time) {
+  uint8_t bit = BUTTON_BIT(button);
+  if (pressed && (pressedMask & bit)) return false;
+  
+  edgeTime[button] = time;
+  if (pressed) {
+    levelMask |= bit;
+    pressedMask |= bit;
+    nextRepeat[button] = time + BUTTON_DELAY * 1000UL;
+    lastButtonTime = time;
+#if TRACK_INPUT_LATENCY
+    latencyTracker.pressCaptured(time);
+#endif
+  } else {
+    levelMask &= ~bit;
+    releasedMask |= bit;
+  }
+  return true;
+}
+
+// Takes the level a bounce ended on once its window is over at `time`
+static bool settle(uint8_t button, unsigned long time) {
+  uint8_t bit = BUTTON_BIT(button);
+  if (!((rawMask ^ levelMask) & bit) || time - edgeTime[button] < DEBOUNCE_MICROS) return true;
+  return applyEdge(button, rawMask & bit, edgeTime[button] + DEBOUNCE_MICROS);
+}
+
+static void syncButtons(unsigned long now) {
+  // Queue overflowed, so the edges are incomplete: start over from the pins
+  InputEvent event;
+  while (inputQueue.peek(event)) inputQueue.pop();
+  
+  rawMask = sampleButtons();
+  uint8_t changed = rawMask ^ levelMask;
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (changed & BUTTON_BIT(i)) applyEdge(i, rawMask & BUTTON_BIT(i), now);
+  }
+}
 
 void initInput() {
-  pinMode(PIN_BUTTON_UP, INPUT_PULLUP);
-  pinMode(PIN_BUTTON_DOWN, INPUT_PULLUP);
-  pinMode(PIN_BUTTON_LEFT, INPUT_PULLUP);
-  pinMode(PIN_BUTTON_RIGHT, INPUT_PULLUP);
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    pinMode(buttonPins[i], INPUT_PULLUP);
+    edgeTime[i] = now - DEBOUNCE_MICROS;
+    nextRepeat[i] = now;
+  }
+  levelMask = 0;
+  rawMask = 0;
+  pressedMask = 0;
+  releasedMask = 0;
   
   // Initialize button states
-  buttons = {false, false, false, false, false, false, false, false};
-  lastButtons = buttons;
+  buttonMasks = {0, 0, 0, 0, 0};
+  buttons = {false, false, false, false, false, false, false, false,
+             false, false, false, false};
+
+#if INPUT_INTERRUPTS_ENABLED
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    attachInterruptArg(digitalPinToInterrupt(buttonPins[i]), buttonInterrupt, (void*)(uintptr_t)i, CHANGE);
+  }
+  
+  // A button held since boot counts as pressed, as it did with polling
+  uint8_t held = sampleButtons();
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (held & BUTTON_BIT(i)) inputQueue.push(i, true, now);
+  }
+#endif
 }
 
-void updateInput() {
-  // Store previous state
-  lastButtons = buttons;
+static void publishButtons(uint8_t current, uint8_t pressed, uint8_t released, uint8_t repeat) {
+  buttonMasks.previous = buttonMasks.current;
+  buttonMasks.current = current;
+  buttonMasks.pressed = pressed;
+  buttonMasks.released = released;
+  buttonMasks.repeat = repeat;
+  
+  buttons.up = isButtonDown(BUTTON_UP);
+  buttons.down = isButtonDown(BUTTON_DOWN);
+  buttons.left = isButtonDown(BUTTON_LEFT);
+  buttons.right = isButtonDown(BUTTON_RIGHT);
   
-  // Read current state (inverted because of INPUT_PULLUP)
-  buttons.up = (digitalRead(PIN_BUTTON_UP) == LOW);
-  buttons.down = (digitalRead(PIN_BUTTON_DOWN) == LOW);
-  buttons.left = (digitalRead(PIN_BUTTON_LEFT) == LOW);
-  buttons.right = (digitalRead(PIN_BUTTON_RIGHT) == LOW);
+  buttons.upPressed = wasButtonPressed(BUTTON_UP);
+  buttons.downPressed = wasButtonPressed(BUTTON_DOWN);
+  buttons.leftPressed = wasButtonPressed(BUTTON_LEFT);
+  buttons.rightPressed = wasButtonPressed(BUTTON_RIGHT);
   
-  // Detect button press events (just pressed)
-  buttons.upPressed = buttons.up && !lastButtons.up;
-  buttons.downPressed = buttons.down && !lastButtons.down;
-  buttons.leftPressed = buttons.left && !lastButtons.left;
-  buttons.rightPressed = buttons.right && !lastButtons.right;
+  buttons.upRepeat = isButtonRepeat(BUTTON_UP);
+  buttons.downRepeat = isButtonRepeat(BUTTON_DOWN);
+  buttons.leftRepeat = isButtonRepeat(BUTTON_LEFT);
+  buttons.rightRepeat = isButtonRepeat(BUTTON_RIGHT);
 }
 
-bool isButtonPressed(int pin) {
-  switch(pin) {
-    case PIN_BUTTON_UP: return buttons.up;
-    case PIN_BUTTON_DOWN: return buttons.down;
-    case PIN_BUTTON_LEFT: return buttons.left;
-    case PIN_BUTTON_RIGHT: return buttons.right;
-    default: return false;
+void discardInput() {
+  // Queued edges are dropped and held buttons stay held without a press
+  InputEvent event;
+  while (inputQueue.peek(event)) inputQueue.pop();
+  
+  unsigned long now = micros();
+  rawMask = sampleButtons();
+  levelMask = rawMask;
+#if !INPUT_INTERRUPTS_ENABLED
+  polledMask = rawMask;
+#endif
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    edgeTime[i] = now - DEBOUNCE_MICROS;
+    nextRepeat[i] = now + BUTTON_DELAY * 1000UL;
   }
 }
 
-bool wasButtonJustPressed(int pin) {
-  switch(pin) {
-    case PIN_BUTTON_UP: return buttons.upPressed;
-    case PIN_BUTTON_DOWN: return buttons.downPressed;
-    case PIN_BUTTON_LEFT: return buttons.leftPressed;
-    case PIN_BUTTON_RIGHT: return buttons.rightPressed;
-    default: return false;
+void updateInput() {
+  PROFILE_SCOPE(PROFILE_INPUT);
+  
+  // A loaded recording stands in for the buttons and the clock until it ends
+  ButtonMasks replayed;
+  unsigned long replayedTime;
+  if (inputReplay.playFrame(replayed, replayedTime)) {
+    frameClock.set(replayedTime);
+    publishButtons(replayed.current, replayed.pressed, replayed.released, replayed.repeat);
+    return;
   }
-}
\ No newline at end of file
+
+#if !INPUT_INTERRUPTS_ENABLED
+  pollButtons();
+#endif
+  unsigned long now = micros();
+  
+  pressedMask = 0;
+  releasedMask = 0;
+  
+  if (inputQueue.getTotalDropped() != droppedSeen) {
+    droppedSeen = inputQueue.getTotalDropped();
+    syncButtons(now);
+  }
+  
+  // Consume edges in order. A second press of a button stays queued for
+  // the next update, so taps faster than the frame rate are not lost.
+  bool drained = true;
+  InputEvent event;
+  while (inputQueue.peek(event)) {
+    // A bounce that ended before this edge moves the level first, the edge
+    // is then judged against that level and its window
+    if (!settle(event.button, event.time)) {
+      drained = false;
+      break;
+    }
+    
+    uint8_t bit = BUTTON_BIT(event.button);
+    bool level = levelMask & bit;
+    bool outsideWindow = event.time - edgeTime[event.button] >= DEBOUNCE_MICROS;
+    if (outsideWindow && event.pressed != level && !applyEdge(event.button, event.pressed, event.time)) {
+      drained = false;
+      break;
+    }
+    rawMask = event.pressed ? (rawMask | bit) : (rawMask & ~bit);
+    inputQueue.pop();
+  }
+  
+  uint8_t repeatMask = pressedMask;
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (drained) settle(i, now);
+    
+    uint8_t bit = BUTTON_BIT(i);
+    if (pressedMask & bit) {
+      repeatMask |= bit;
+    } else if ((levelMask & bit) && (long)(now - nextRepeat[i]) >= 0) {
+      repeatMask |= bit;
+      nextRepeat[i] += BUTTON_REPEAT_RATE * 1000UL;
+      // After a long frame repeat from now instead of catching up
+      if ((long)(now - nextRepeat[i]) >= 0) nextRepeat[i] = now + BUTTON_REPEAT_RATE * 1000UL;
+    }
+  }
+  
+  publishButtons(levelMask, pressedMask, releasedMask, repeatMask);
+  
+  if (inputReplay.getMode() == REPLAY_RECORDING) inputReplay.recordFrame(buttonMasks, frameClock.now());
+}
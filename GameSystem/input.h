@@ -2,7 +2,42 @@
 #define INPUT_H
 
 #include "config.h"
+#include <atomic>
 
+#if USE_INPUT_INTERRUPTS && defined(ESP32)
+#define INPUT_INTERRUPTS_ENABLED 1
+#else
+#define INPUT_INTERRUPTS_ENABLED 0
+#endif
+
+// All buttons are read from the one GPIO input register when they are
+// below GPIO 32, otherwise pin by pin
+#if defined(ESP32) && PIN_BUTTON_UP < 32 && PIN_BUTTON_DOWN < 32 && PIN_BUTTON_LEFT < 32 && PIN_BUTTON_RIGHT < 32
+#define INPUT_REGISTER_SAMPLING 1
+#else
+#define INPUT_REGISTER_SAMPLING 0
+#endif
+
+enum Button {
+  BUTTON_UP = 0,
+  BUTTON_DOWN,
+  BUTTON_LEFT,
+  BUTTON_RIGHT,
+  BUTTON_COUNT
+};
+
+#define BUTTON_BIT(b) (1 << (b))
+
+// Button levels packed one bit per Button, set while held
+struct ButtonMasks {
+  uint8_t current;   // Debounced levels
+  uint8_t previous;  // Debounced levels at the update before
+  uint8_t pressed;   // Pressed since the last update
+  uint8_t released;  // Released since the last update
+  uint8_t repeat;    // Pressed, or held past BUTTON_DELAY and due for a repeat
+};
+
+// Same state as buttonMasks, kept for the games that read the fields
 struct ButtonState {
   bool up;
   bool down;
@@ -12,14 +47,74 @@ struct ButtonState {
   bool downPressed;
   bool leftPressed;
   bool rightPressed;
+  // Pressed this update, or held past BUTTON_DELAY and due for a repeat
+  bool upRepeat;
+  bool downRepeat;
+  bool leftRepeat;
+  bool rightRepeat;
 };
 
+// One level change of a button
+struct InputEvent {
+  unsigned long time;  // micros() of the edge
+  uint8_t button;
+  bool pressed;
+};
+
+// Lock-free ring of button edges with one producer, the GPIO interrupts or
+// the polling fallback, and one consumer, updateInput(). The counters run
+// freely and are masked into the ring.
+class InputQueue {
+private:
+  InputEvent events[INPUT_QUEUE_SIZE];
+  std::atomic<uint32_t> head;  // Written by the producer only
+  std::atomic<uint32_t> tail;  // Written by the consumer only
+  volatile unsigned long pushed;
+  volatile unsigned long dropped;
+  unsigned long pushedBase;
+  unsigned long droppedBase;
+  
+public:
+  InputQueue() : head(0), tail(0), pushed(0), dropped(0), pushedBase(0), droppedBase(0) {}
+  bool push(uint8_t button, bool pressed, unsigned long time);
+  bool peek(InputEvent& event);
+  void pop() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+  void resetStats();
+  unsigned long getPushed() { return pushed - pushedBase; }
+  unsigned long getDropped() { return dropped - droppedBase; }
+  unsigned long getTotalDropped() { return dropped; }
+};
+
+extern ButtonMasks buttonMasks;
 extern ButtonState buttons;
-extern unsigned long lastButtonTime;
+extern unsigned long lastButtonTime; // micros() of the last accepted press
+extern InputQueue inputQueue;
 
 void initInput();
 void updateInput();
-bool isButtonPressed(int pin);
-bool wasButtonJustPressed(int pin);
+void discardInput();  // Forget the edges so far, held buttons are not presses
+
+// Bit of the button on a pin, 0 for other pins. Callers pass the
+// PIN_BUTTON_* constants, so the lookup folds to a constant mask.
+constexpr uint8_t pinBit(int pin) {
+  return pin == PIN_BUTTON_UP ? BUTTON_BIT(BUTTON_UP) :
+         pin == PIN_BUTTON_DOWN ? BUTTON_BIT(BUTTON_DOWN) :
+         pin == PIN_BUTTON_LEFT ? BUTTON_BIT(BUTTON_LEFT) :
+         pin == PIN_BUTTON_RIGHT ? BUTTON_BIT(BUTTON_RIGHT) : 0;
+}
+
+inline bool isButtonPressed(int pin) { return buttonMasks.current & pinBit(pin); }
+inline bool wasButtonJustPressed(int pin) { return buttonMasks.pressed & pinBit(pin); }
+inline bool isButtonDown(Button b) { return (buttonMasks.current >> b) & 1; }
+inline bool wasButtonPressed(Button b) { return (buttonMasks.pressed >> b) & 1; }
+inline bool wasButtonReleased(Button b) { return (buttonMasks.released >> b) & 1; }
+inline bool isButtonRepeat(Button b) { return (buttonMasks.repeat >> b) & 1; }
+
+// Raw levels of all buttons, bounce included, in one read
+uint8_t sampleButtons();
+
+// Queues an edge as if the button's interrupt had fired, for scripting
+// input on a host build. Returns false when the queue is full.
+bool injectInputEvent(uint8_t button, bool pressed, unsigned long time);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,132 @@
+#include "latency.h"
+
+LatencyTracker latencyTracker;
+
+void LatencyHistogram::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  count = 0;
+  minMicros = 0;
+  maxMicros = 0;
+}
+
+uint8_t LatencyHistogram::bucketOf(unsigned long micros) {
+  uint32_t units = micros / LATENCY_UNIT_MICROS;
+  if (units < 16) return units;
+  
+  // Top bit picks the doubling, the three below it the eighth within it
+  uint8_t top = 31 - __builtin_clz(units);
+  uint32_t bucket = 16 + (top - 4) * 8 + ((units >> (top - 3)) & 7);
+  return (bucket < LATENCY_BUCKETS) ? bucket : LATENCY_BUCKETS - 1;
+}
+
+unsigned long LatencyHistogram::bucketEnd(uint8_t bucket) {
+  if (bucket < 16) return (bucket + 1) * (unsigned long)LATENCY_UNIT_MICROS;
+  uint8_t shift = (bucket - 16) / 8 + 1;
+  return ((9UL + (bucket - 16) % 8) << shift) * LATENCY_UNIT_MICROS;
+}
+
+void LatencyHistogram::add(unsigned long micros) {
+  uint8_t bucket = bucketOf(micros);
+  if (buckets[bucket] < UINT16_MAX) buckets[bucket]++;
+  
+  if (count == 0 || micros < minMicros) minMicros = micros;
+  if (micros > maxMicros) maxMicros = micros;
+  count++;
+}
+
+unsigned long LatencyHistogram::percentile(uint8_t percent) {
+  // Rank of the sample below which `percent` of them fall, rounded up
+  unsigned long rank = (count * percent + 99) / 100;
+  unsigned long seen = 0;
+  for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++) {
+    seen += buckets[i];
+    if (seen >= rank) return min(bucketEnd(i), maxMicros);
+  }
+  return maxMicros;
+}
+
+LatencyStats LatencyHistogram::getStats() {
+  LatencyStats stats = {count, minMicros, 0, 0, maxMicros};
+  if (count > 0) {
+    stats.p50 = percentile(50);
+    stats.p99 = percentile(99);
+  }
+  return stats;
+}
+
+uint32_t olderLatencyTag(uint32_t a, uint32_t b) {
+  if (a == LATENCY_NO_TAG) return b;
+  if (b == LATENCY_NO_TAG) return a;
+  return ((long)(a - b) <= 0) ? a : b;
+}
+
+void LatencyTracker::setGame(int gameId) {
+  game = (gameId >= 0 && gameId < MAX_GAMES) ? gameId : -1;
+  pendingTag = LATENCY_NO_TAG;
+}
+
+void LatencyTracker::resetStats(int gameId) {
+  collect();
+  if (gameId >= 0 && gameId < MAX_GAMES) histograms[gameId].reset();
+}
+
+void LatencyTracker::pressCaptured(unsigned long time) {
+  if (game < 0) return;
+  
+  // A press at micros() 0 would read as no press, it is moved by 1 us
+  uint32_t tag = (time == LATENCY_NO_TAG) ? 1 : time;
+  pendingTag = olderLatencyTag(pendingTag, tag);
+}
+
+uint32_t LatencyTracker::takeFrameTag() {
+  collect();
+  uint32_t tag = pendingTag;
+  pendingTag = LATENCY_NO_TAG;
+  return tag;
+}
+
+void LatencyTracker::frameFlushed(uint32_t tag, unsigned long now) {
+  int current = game;
+  if (tag == LATENCY_NO_TAG || current < 0) return;
+  
+  // Queued for the game loop; a full ring means it has stopped collecting
+  uint32_t h = flushedHead.load(std::memory_order_relaxed);
+  if (h - flushedTail.load(std::memory_order_acquire) >= LATENCY_PENDING) return;
+  Sample& sample = flushed[h & (LATENCY_PENDING - 1)];
+  sample.micros = now - tag;
+  sample.game = current;
+  flushedHead.store(h + 1, std::memory_order_release);
+}
+
+void LatencyTracker::collect() {
+  uint32_t t = flushedTail.load(std::memory_order_relaxed);
+  uint32_t h = flushedHead.load(std::memory_order_acquire);
+  for (; t != h; t++) {
+    const Sample& sample = flushed[t & (LATENCY_PENDING - 1)];
+    histograms[sample.game].add(sample.micros);
+  }
+  flushedTail.store(t, std::memory_order_release);
+}
+
+LatencyStats LatencyTracker::getStats(int gameId) {
+  if (gameId < 0 || gameId >= MAX_GAMES) return LatencyStats{0, 0, 0, 0, 0};
+  collect();
+  return histograms[gameId].getStats();
+}
+
+void LatencyTracker::printStats(int gameId) {
+  LatencyStats stats = getStats(gameId);
+  if (stats.count == 0) return;
+  
+  Serial.print(F("Press to flush: "));
+  Serial.print(stats.min);
+  Serial.print(F(" / "));
+  Serial.print(stats.p50);
+  Serial.print(F(" / "));
+  Serial.print(stats.p99);
+  Serial.print(F(" / "));
+  Serial.print(stats.max);
+  Serial.print(F(" us (min / p50 / p99 / max) over "));
+  Serial.print(stats.count);
+  Serial.println(F(" presses"));
+}
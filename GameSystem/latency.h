@@ -0,0 +1,84 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "config.h"
+#include <atomic>
+
+// Buckets are LATENCY_UNIT_MICROS wide up to 16 units, after that every
+// doubling is split into 8, so the error stays within 1/8. 72 buckets
+// reach 2048 units; the last bucket also takes everything slower.
+#define LATENCY_UNIT_MICROS 250
+#define LATENCY_BUCKETS 72
+#define LATENCY_NO_TAG 0            // Frame tags are press capture times, 0 for no press
+#define LATENCY_PENDING 8           // Flushed presses waiting for the game loop, power of two
+
+// Press-to-flush times of one game in microseconds. The percentiles are
+// the upper edge of their bucket, min and max are exact.
+struct LatencyStats {
+  unsigned long count;
+  unsigned long min;
+  unsigned long p50;
+  unsigned long p99;
+  unsigned long max;
+};
+
+class LatencyHistogram {
+private:
+  uint16_t buckets[LATENCY_BUCKETS];
+  unsigned long count;
+  unsigned long minMicros;
+  unsigned long maxMicros;
+  
+  static uint8_t bucketOf(unsigned long micros);
+  static unsigned long bucketEnd(uint8_t bucket);
+  unsigned long percentile(uint8_t percent);
+
+public:
+  LatencyHistogram() { reset(); }
+  void reset();
+  void add(unsigned long micros);
+  LatencyStats getStats();
+};
+
+// Measures the time from a button press to the end of the flush of the
+// first frame rendered after it. updateInput() reports accepted presses,
+// updateDisplay() tags the next frame with the oldest press it is the
+// first to show and the tag travels with the frame until it is flushed,
+// on the game loop or on the flush task. Only presses while a game is
+// playing are measured.
+//
+// The flush task only queues its measured times, in a lock-free ring like
+// InputQueue's; the histograms are touched by the game loop alone, which
+// collects the ring before it tags, reads or resets them.
+class LatencyTracker {
+private:
+  struct Sample {
+    unsigned long micros;
+    int game;
+  };
+  
+  LatencyHistogram histograms[MAX_GAMES];
+  volatile int game;    // Game the flushed frames belong to, -1 for none
+  uint32_t pendingTag;  // Capture time of the oldest press no frame shows yet
+  Sample flushed[LATENCY_PENDING];
+  std::atomic<uint32_t> flushedHead;  // Written by frameFlushed() only
+  std::atomic<uint32_t> flushedTail;  // Written by the game loop only
+  
+  void collect();
+
+public:
+  LatencyTracker() : game(-1), pendingTag(LATENCY_NO_TAG), flushedHead(0), flushedTail(0) {}
+  void setGame(int gameId);
+  void resetStats(int gameId);  // A new game starts, its old presses go
+  void pressCaptured(unsigned long time);
+  uint32_t takeFrameTag();
+  void frameFlushed(uint32_t tag, unsigned long now);
+  LatencyStats getStats(int gameId);
+  void printStats(int gameId);
+};
+
+uint32_t olderLatencyTag(uint32_t a, uint32_t b);
+
+extern LatencyTracker latencyTracker;
+
+#endif
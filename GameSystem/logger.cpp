@@ -0,0 +1,71 @@
+#include "logger.h"
+
+#if LOG_LEVEL > LOG_LEVEL_NONE
+Logger logger;
+
+static const char levelTags[] = "-EWID";
+
+void Logger::put(const void* bytes, uint8_t size) {
+  const uint8_t* source = (const uint8_t*)bytes;
+  for (uint8_t i = 0; i < size; i++) {
+    data[head] = source[i];
+    head = (head + 1) % LOG_BUFFER_SIZE;
+  }
+  used += size;
+}
+
+void Logger::peek(uint16_t at, void* bytes, uint8_t size) {
+  uint8_t* target = (uint8_t*)bytes;
+  for (uint8_t i = 0; i < size; i++) {
+    target[i] = data[(at + i) % LOG_BUFFER_SIZE];
+  }
+}
+
+void Logger::push(uint8_t level, const char* format, const int32_t* args, uint8_t count) {
+  uint8_t size = 1 + sizeof(format) + count * sizeof(int32_t);
+  if (used + size > LOG_BUFFER_SIZE) {
+    dropped++;
+    return;
+  }
+  
+  uint8_t header = level << 4 | count;
+  put(&header, 1);
+  put(&format, sizeof(format));
+  put(args, count * sizeof(int32_t));
+}
+
+void Logger::drain() {
+  char line[LOG_LINE_SIZE];
+  
+  while (used > 0) {
+    uint8_t header;
+    const char* format;
+    int32_t args[LOG_MAX_ARGS] = {0, 0, 0, 0};
+    peek(tail, &header, 1);
+    peek(tail + 1, &format, sizeof(format));
+    uint8_t count = header & 0x0F;
+    peek(tail + 1 + sizeof(format), args, count * sizeof(int32_t));
+    
+    // Unused arguments are passed as zeros and ignored by the format
+    int length = snprintf(line, sizeof(line), format, (int)args[0], (int)args[1], (int)args[2], (int)args[3]);
+    if (length >= (int)sizeof(line)) length = sizeof(line) - 1;
+    
+    // Tag, message and line break, or wait for the UART to empty
+    if (Serial.availableForWrite() < length + 5) return;
+    Serial.print(levelTags[min(header >> 4, LOG_LEVEL_DEBUG)]);
+    Serial.print(F(": "));
+    Serial.println(line);
+    
+    uint8_t size = 1 + sizeof(format) + count * sizeof(int32_t);
+    tail = (tail + size) % LOG_BUFFER_SIZE;
+    used -= size;
+  }
+  
+  // Entries were dropped after everything that was printed
+  if (dropped > 0 && Serial.availableForWrite() >= 40) {
+    Serial.print(F("Log: dropped "));
+    Serial.println(dropped);
+    dropped = 0;
+  }
+}
+#endif
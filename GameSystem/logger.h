@@ -0,0 +1,92 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include "config.h"
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#define LOG_MAX_ARGS 4
+#define LOG_LINE_SIZE 96  // Longest formatted message, longer ones are cut
+
+// Log messages are not formatted or printed where they happen. An entry is
+// the level, the address of the format string, which stays valid because
+// it is a literal, and up to four ints, copied into a ring buffer:
+//
+//   level << 4 | count, format pointer, count ints
+//
+// drain() formats and prints them while the loop has time left before the
+// next tick, and only as much as the UART takes without blocking, so logging
+// does not move frame timing. Entries that do not fit are counted and
+// reported. Only log from the game loop.
+class Logger {
+private:
+  uint8_t data[LOG_BUFFER_SIZE];
+  uint16_t head;  // Next byte to write
+  uint16_t tail;  // Next byte to drain
+  uint16_t used;
+  unsigned long dropped;
+  
+  void put(const void* bytes, uint8_t size);
+  void peek(uint16_t at, void* bytes, uint8_t size);
+  
+public:
+  Logger() : head(0), tail(0), used(0), dropped(0) {}
+  void push(uint8_t level, const char* format, const int32_t* args, uint8_t count);
+  void drain();
+  unsigned long getDropped() { return dropped; }
+};
+
+extern Logger logger;
+
+template <typename... Args>
+inline void logWrite(uint8_t level, const char* format, Args... args) {
+  static_assert(sizeof...(args) <= LOG_MAX_ARGS, "at most LOG_MAX_ARGS log arguments");
+  const int32_t values[] = {(int32_t)args..., 0};
+  logger.push(level, format, values, sizeof...(args));
+}
+
+// Stands in for logWrite() at levels that are compiled out, so their
+// arguments still count as used and still have to be valid
+template <typename... Args>
+inline void logDiscard(const char* format, Args... args) {
+  static_assert(sizeof...(args) <= LOG_MAX_ARGS, "at most LOG_MAX_ARGS log arguments");
+}
+
+// printf style with %d, %u and %X for the ints. Levels above LOG_LEVEL
+// compile to nothing and their arguments are not evaluated.
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do { if (0) logDiscard(__VA_ARGS__); } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do { if (0) logDiscard(__VA_ARGS__); } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do { if (0) logDiscard(__VA_ARGS__); } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do { if (0) logDiscard(__VA_ARGS__); } while (0)
+#endif
+
+// Called in idle time, nothing to do when logging is off
+#if LOG_LEVEL > LOG_LEVEL_NONE
+inline void drainLog() { logger.drain(); }
+#else
+inline void drainLog() {}
+#endif
+
+#endif
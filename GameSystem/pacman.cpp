@@ -1,8 +1,9 @@
 #include "pacman.h"
 #include "display.h"
 #include "input.h"
-
-PacManGame pacmanGame;
+#include "frameclock.h"
+#include "replay.h"
+#include "background.h"
 
 // Simple maze layout (0=wall, 1=dot, 2=empty, 3=pacman start, 4=ghost start)
 const uint8_t mazeLayout[MAZE_HEIGHT][MAZE_WIDTH] = {
@@ -34,7 +35,7 @@ void PacManGame::init() {
           if (!ghosts[i].active) {
             ghosts[i].x = x;
             ghosts[i].y = y;
-            ghosts[i].direction = random(0, 4);
+            ghosts[i].direction = gameRandom(0, 4);
             ghosts[i].active = true;
             ghosts[i].lastMove = 0;
             maze[y][x] = 2; // Empty space
@@ -48,6 +49,7 @@ void PacManGame::init() {
   score = 0;
   dotsEaten = 0;
   gameOver = false;
+  frameVersion = 0;
   gameWon = false;
   lastMove = 0;
   lastGhostMove = 0;
@@ -57,18 +59,20 @@ void PacManGame::init() {
 void PacManGame::update() {
   handleInput();
   
-  unsigned long currentTime = millis();
+  unsigned long currentTime = frameClock.now();
   
   // Update Pac-Man
   if (currentTime - lastMove > moveDelay) {
     updatePacMan();
     lastMove = currentTime;
+    frameVersion++;
   }
   
   // Update ghosts (slower)
   if (currentTime - lastGhostMove > moveDelay + 100) {
     updateGhosts();
     lastGhostMove = currentTime;
+    frameVersion++;
   }
   
   // Check collisions
@@ -84,9 +88,12 @@ void PacManGame::update() {
 }
 
 void PacManGame::draw() {
-  clearDisplay();
+  if (!backgroundCache.restore()) {
+    clearDisplay();
+    drawMaze();
+    backgroundCache.capture();
+  }
   
-  drawMaze();
   drawGhosts();
   drawPacMan();
   drawUI();
@@ -111,6 +118,7 @@ void PacManGame::handleInput() {
 
 void PacManGame::generateMaze() {
   dotsEaten = 0;
+  backgroundCache.invalidate();
   
   // Copy layout to maze
   for (int y = 0; y < MAZE_HEIGHT; y++) {
@@ -159,6 +167,7 @@ void PacManGame::updatePacMan() {
       maze[pacman.y][pacman.x] = 2;
       score += 10;
       dotsEaten++;
+      backgroundCache.invalidate(); // Dots are part of the maze background
     }
   }
 }
@@ -170,8 +179,8 @@ void PacManGame::updateGhosts() {
     // Simple AI: try to move towards Pac-Man, but sometimes random
     int bestDirection = ghosts[i].direction;
     
-    if (random(0, 4) == 0) { // 25% chance of random movement
-      bestDirection = random(0, 4);
+    if (gameRandom(0, 4) == 0) { // 25% chance of random movement
+      bestDirection = gameRandom(0, 4);
     } else {
       // Move towards Pac-Man
       int dx = pacman.x - ghosts[i].x;
@@ -249,7 +258,7 @@ void PacManGame::drawMaze() {
         display.fillRect(screenX, screenY, CELL_SIZE, CELL_SIZE, SSD1306_WHITE);
       }
       else if (maze[y][x] == 1) { // Dot
-        display.fillCircle(screenX + CELL_SIZE/2, screenY + CELL_SIZE/2, 1, SSD1306_WHITE);
+        display.drawSprite(spriteDot, screenX + CELL_SIZE/2, screenY + CELL_SIZE/2);
       }
     }
   }
@@ -259,27 +268,8 @@ void PacManGame::drawPacMan() {
   int screenX = pacman.x * CELL_SIZE + CELL_SIZE/2;
   int screenY = pacman.y * CELL_SIZE + CELL_SIZE/2;
   
-  display.fillCircle(screenX, screenY, 3, SSD1306_WHITE);
-  
-  // Draw mouth based on direction
-  switch (pacman.direction) {
-    case 0: // right
-      display.drawLine(screenX, screenY, screenX + 2, screenY - 1, SSD1306_BLACK);
-      display.drawLine(screenX, screenY, screenX + 2, screenY + 1, SSD1306_BLACK);
-      break;
-    case 1: // down
-      display.drawLine(screenX, screenY, screenX - 1, screenY + 2, SSD1306_BLACK);
-      display.drawLine(screenX, screenY, screenX + 1, screenY + 2, SSD1306_BLACK);
-      break;
-    case 2: // left
-      display.drawLine(screenX, screenY, screenX - 2, screenY - 1, SSD1306_BLACK);
-      display.drawLine(screenX, screenY, screenX - 2, screenY + 1, SSD1306_BLACK);
-      break;
-    case 3: // up
-      display.drawLine(screenX, screenY, screenX - 1, screenY - 2, SSD1306_BLACK);
-      display.drawLine(screenX, screenY, screenX + 1, screenY - 2, SSD1306_BLACK);
-      break;
-  }
+  // Mouth faces the direction of travel
+  display.drawSprite(spritePacman[pacman.direction], screenX, screenY);
 }
 
 void PacManGame::drawGhosts() {
@@ -287,19 +277,7 @@ void PacManGame::drawGhosts() {
     if (ghosts[i].active) {
       int screenX = ghosts[i].x * CELL_SIZE + CELL_SIZE/2;
       int screenY = ghosts[i].y * CELL_SIZE + CELL_SIZE/2;
-      
-      // Draw ghost body
-      display.fillCircle(screenX, screenY - 1, 3, SSD1306_WHITE);
-      display.fillRect(screenX - 3, screenY, 6, 3, SSD1306_WHITE);
-      
-      // Draw ghost bottom (wavy)
-      display.drawPixel(screenX - 2, screenY + 3, SSD1306_WHITE);
-      display.drawPixel(screenX, screenY + 2, SSD1306_WHITE);
-      display.drawPixel(screenX + 2, screenY + 3, SSD1306_WHITE);
-      
-      // Draw eyes
-      display.drawPixel(screenX - 1, screenY - 2, SSD1306_BLACK);
-      display.drawPixel(screenX + 1, screenY - 2, SSD1306_BLACK);
+      display.drawSprite(spriteGhost, screenX, screenY);
     }
   }
 }
@@ -311,10 +289,32 @@ void PacManGame::drawUI() {
   // Score (bottom area)
   display.setCursor(0, SCREEN_HEIGHT - 8);
   display.print(F("Score: "));
-  display.print(score);
+  display.printNumber(score);
   
   // Dots remaining
   display.setCursor(70, SCREEN_HEIGHT - 8);
   display.print(F("Dots: "));
-  display.print(TOTAL_DOTS - dotsEaten);
-}
\ No newline at end of file
+  display.printNumber(TOTAL_DOTS - dotsEaten);
+}
+
+void PacManGame::serialize(SaveStream& state) {
+  state.value(pacman.x);
+  state.value(pacman.y);
+  state.value(pacman.direction);
+  state.value(pacman.nextDirection);
+  for (int i = 0; i < MAX_GHOSTS; i++) {
+    state.value(ghosts[i].x);
+    state.value(ghosts[i].y);
+    state.value(ghosts[i].direction);
+    state.value(ghosts[i].active);
+    state.time(ghosts[i].lastMove);
+  }
+  state.bytes(maze, sizeof(maze));
+  state.value(score);
+  state.value(dotsEaten);
+  state.value(gameOver);
+  state.value(gameWon);
+  state.time(lastMove);
+  state.time(lastGhostMove);
+  state.value(moveDelay);
+}
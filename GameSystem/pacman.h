@@ -2,6 +2,7 @@
 #define PACMAN_H
 
 #include "config.h"
+#include "savestate.h"
 
 #define MAZE_WIDTH 16
 #define MAZE_HEIGHT 8
@@ -30,6 +31,7 @@ private:
   int score;
   int dotsEaten;
   bool gameOver;
+  unsigned long frameVersion;
   bool gameWon;
   unsigned long lastMove;
   unsigned long lastGhostMove;
@@ -50,12 +52,12 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  unsigned long getFrameVersion() { return frameVersion; }
   bool isGameWon() { return gameWon; }
   int getScore() { return score; }
   const char* getName() { return "PAC-MAN"; }
 };
 
-extern PacManGame pacmanGame;
-
 #endif
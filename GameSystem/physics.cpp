@@ -0,0 +1,29 @@
+#include "physics.h"
+
+void PhysicsClock::begin(unsigned long stepMs, unsigned long now) {
+  stepMillis = stepMs;
+  lastTime = now;
+  accumulator = 0;
+  stepTime = now;
+}
+
+uint8_t PhysicsClock::advance(unsigned long now) {
+  accumulator += now - lastTime;
+  lastTime = now;
+  
+  unsigned long due = accumulator / stepMillis;
+  accumulator -= due * stepMillis;
+  if (due > PHYSICS_MAX_STEPS) {
+    // Too far behind to catch up, the bodies slow down instead
+    stepTime += (due - PHYSICS_MAX_STEPS) * stepMillis;
+    due = PHYSICS_MAX_STEPS;
+  }
+  return due;
+}
+
+void PhysicsClock::serialize(SaveStream& state) {
+  // The step length comes from begin()
+  state.time(lastTime);
+  state.value(accumulator);
+  state.time(stepTime);
+}
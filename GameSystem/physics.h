@@ -0,0 +1,66 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "config.h"
+#include "fixed.h"
+#include "savestate.h"
+
+#define PHYSICS_MAX_STEPS 8 // Steps run in one update, the rest is dropped
+
+// Moving object of a game, in sub-pixels and sub-pixels per step. Every
+// step adds the acceleration to the velocity and then the velocity to the
+// position, the same explicit order the games always used.
+struct Body {
+  Fixed x, y;
+  Fixed velX, velY;
+  Fixed lastX, lastY;  // Position before the last step
+  
+  void place(Fixed newX, Fixed newY) {
+    x = lastX = newX;
+    y = lastY = newY;
+  }
+  
+  void step(Fixed accelX, Fixed accelY) {
+    lastX = x;
+    lastY = y;
+    velX += accelX;
+    velY += accelY;
+    x += velX;
+    y += velY;
+  }
+  
+  // Pixel to draw at, carried on by the part of a step that passed since
+  // the last one, so drawing more often than stepping still shows movement
+  int drawX(Fixed alpha) const { return (x + (x - lastX) * alpha).toInt(); }
+  int drawY(Fixed alpha) const { return (y + (y - lastY) * alpha).toInt(); }
+  
+  void serialize(SaveStream& state) {
+    state.value(x);
+    state.value(y);
+    state.value(velX);
+    state.value(velY);
+    state.value(lastX);
+    state.value(lastY);
+  }
+};
+
+// Splits game time into fixed physics steps. The game runs its physics
+// once per step returned by advance(), so bodies follow the same path
+// whether the ticks are 8 or 33 ms apart, and the time left over gives
+// the fraction of a step to draw the bodies ahead by.
+class PhysicsClock {
+private:
+  unsigned long stepMillis;
+  unsigned long lastTime;     // Game time the clock was last advanced to
+  unsigned long accumulator;  // Game time not yet turned into steps
+  unsigned long stepTime;     // Game time of the last step run
+  
+public:
+  void begin(unsigned long stepMs, unsigned long now);
+  uint8_t advance(unsigned long now);
+  void serialize(SaveStream& state);
+  unsigned long nextStep() { return stepTime += stepMillis; } // Game time of each step in turn
+  Fixed alpha() { return Fixed::fromRaw(accumulator * FIXED_ONE / stepMillis); }
+};
+
+#endif
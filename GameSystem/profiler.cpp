@@ -0,0 +1,160 @@
+#include "profiler.h"
+
+#if ENABLE_PROFILER
+#define PROFILE_DUMP_SIZE 512
+
+Profiler profiler;
+
+static uint8_t dumpData[PROFILE_DUMP_SIZE];
+static uint16_t dumpLength;
+
+static void dumpByte(uint8_t value) {
+  if (dumpLength < PROFILE_DUMP_SIZE) dumpData[dumpLength++] = value;
+}
+
+static void dumpVarint(uint32_t value) {
+  // Seven bits per byte, low bits first, top bit set while more follow
+  while (value >= 0x80) {
+    dumpByte((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  dumpByte(value);
+}
+
+static uint8_t bucketOf(uint32_t micros) {
+  uint8_t bucket = micros ? 32 - __builtin_clz(micros) : 0;
+  return (bucket < PROFILE_BUCKETS) ? bucket : PROFILE_BUCKETS - 1;
+}
+
+Profiler::Profiler() : game(-1), phase(PROFILE_PHASES), phaseStart(0) {
+  memset(games, 0, sizeof(games));
+  memset(frameMicros, 0, sizeof(frameMicros));
+}
+
+void Profiler::setGame(int gameId) {
+  game = (gameId >= 0 && gameId < MAX_GAMES) ? gameId : -1;
+  memset(frameMicros, 0, sizeof(frameMicros));
+}
+
+void Profiler::resetStats(int gameId) {
+  if (gameId >= 0 && gameId < MAX_GAMES) memset(&games[gameId], 0, sizeof(GameProfile));
+}
+
+void Profiler::charge(unsigned long now) {
+  if (phase < PROFILE_PHASES) frameMicros[phase] += now - phaseStart;
+  phaseStart = now;
+}
+
+uint8_t Profiler::enter(uint8_t newPhase) {
+  charge(micros());
+  uint8_t parent = phase;
+  phase = newPhase;
+  return parent;
+}
+
+void Profiler::leave(uint8_t parent) {
+  charge(micros());
+  phase = parent;
+}
+
+void Profiler::endFrame() {
+  if (game < 0) return;
+  
+  GameProfile& profile = games[game];
+  for (uint8_t p = 0; p < PROFILE_PHASES; p++) {
+    uint32_t time = frameMicros[p];
+    profile.totalMicros[p] += time;
+    if (time > profile.maxMicros[p]) profile.maxMicros[p] = time;
+    uint16_t& bucket = profile.buckets[p][bucketOf(time)];
+    if (bucket < UINT16_MAX) bucket++;
+  }
+  keepIfWorst(profile);
+  profile.frames++;
+  memset(frameMicros, 0, sizeof(frameMicros));
+}
+
+void Profiler::keepIfWorst(GameProfile& profile) {
+  uint32_t total = 0;
+  for (uint8_t p = 0; p < PROFILE_PHASES; p++) total += frameMicros[p];
+  
+  // Fill the slots first, then replace the fastest kept frame
+  uint8_t slot = profile.worstCount;
+  if (slot == PROFILE_WORST_FRAMES) {
+    uint32_t fastest = UINT32_MAX;
+    for (uint8_t i = 0; i < PROFILE_WORST_FRAMES; i++) {
+      uint32_t kept = 0;
+      for (uint8_t p = 0; p < PROFILE_PHASES; p++) kept += profile.worst[i].micros[p];
+      if (kept < fastest) {
+        fastest = kept;
+        slot = i;
+      }
+    }
+    if (total <= fastest) return;
+  } else {
+    profile.worstCount++;
+  }
+  
+  profile.worst[slot].frame = profile.frames;
+  memcpy(profile.worst[slot].micros, frameMicros, sizeof(frameMicros));
+}
+
+void Profiler::printStats(int gameId) {
+  if (gameId < 0 || gameId >= MAX_GAMES) return;
+  GameProfile& profile = games[gameId];
+  if (profile.frames == 0) return;
+  
+  Serial.print(F("Phases: "));
+  for (uint8_t p = 0; p < PROFILE_PHASES; p++) {
+    if (p > 0) Serial.print(F(" / "));
+    Serial.print(profile.totalMicros[p] / profile.frames);
+  }
+  Serial.print(F(" us/frame (input / update / draw / flush) over "));
+  Serial.print(profile.frames);
+  Serial.println(F(" frames"));
+}
+
+void Profiler::dump(int gameId) {
+  if (gameId < 0 || gameId >= MAX_GAMES) return;
+  GameProfile& profile = games[gameId];
+  if (profile.frames == 0) return;
+  
+  dumpLength = 0;
+  dumpByte('P');
+  dumpByte('F');
+  dumpByte(PROFILE_VERSION);
+  dumpByte(PROFILE_PHASES);
+  dumpByte(PROFILE_BUCKETS);
+  dumpByte(gameId);
+  dumpVarint(profile.frames);
+  
+  for (uint8_t p = 0; p < PROFILE_PHASES; p++) {
+    dumpVarint(profile.totalMicros[p]);
+    dumpVarint(profile.maxMicros[p]);
+    
+    // Only the buckets between the first and the last one in use
+    const uint16_t* buckets = profile.buckets[p];
+    uint8_t first = 0;
+    while (first < PROFILE_BUCKETS && buckets[first] == 0) first++;
+    uint8_t end = PROFILE_BUCKETS;
+    while (end > first && buckets[end - 1] == 0) end--;
+    dumpByte(first);
+    dumpByte(end - first);
+    for (uint8_t b = first; b < end; b++) dumpVarint(buckets[b]);
+  }
+  
+  dumpByte(profile.worstCount);
+  for (uint8_t i = 0; i < profile.worstCount; i++) {
+    dumpVarint(profile.worst[i].frame);
+    for (uint8_t p = 0; p < PROFILE_PHASES; p++) dumpVarint(profile.worst[i].micros[p]);
+  }
+  
+  Serial.print(F("Profile: "));
+  Serial.print(dumpLength);
+  Serial.println(F(" bytes"));
+  for (uint16_t i = 0; i < dumpLength; i++) {
+    if (dumpData[i] < 0x10) Serial.print('0');
+    Serial.print(dumpData[i], HEX);
+    if (i % 32 == 31 || i == dumpLength - 1) Serial.println();
+  }
+}
+#endif
@@ -0,0 +1,88 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+
+// Parts of a frame the profiler tells apart
+enum ProfilePhase {
+  PROFILE_INPUT,   // updateInput()
+  PROFILE_UPDATE,  // The game's update()
+  PROFILE_DRAW,    // The game's draw(), without the flush
+  PROFILE_FLUSH,   // updateDisplay(), the flush or the hand-off to the flush task
+  PROFILE_PHASES
+};
+
+#define PROFILE_BUCKETS 20      // Bucket b holds times below 2^b us, the last also everything slower
+#define PROFILE_WORST_FRAMES 4  // Slowest frames kept per game
+#define PROFILE_VERSION 1
+
+#if ENABLE_PROFILER
+struct ProfileFrame {
+  unsigned long frame;  // Frame number within the game's profile
+  uint32_t micros[PROFILE_PHASES];
+};
+
+struct GameProfile {
+  unsigned long frames;
+  uint32_t totalMicros[PROFILE_PHASES];
+  uint32_t maxMicros[PROFILE_PHASES];
+  uint16_t buckets[PROFILE_PHASES][PROFILE_BUCKETS];
+  ProfileFrame worst[PROFILE_WORST_FRAMES];
+  uint8_t worstCount;
+};
+
+// Splits every loop of a playing game into phases and keeps a histogram
+// per game and phase plus the slowest frames. Phases nest: time spent in
+// an inner scope only counts for the inner phase, so the flush inside a
+// draw is not counted twice.
+//
+// The dump is binary, printed as hex lines at game over like the replay,
+// and read back by tools/decode_profile.py:
+//
+//   'P' 'F' version phases buckets game frames(varint)
+//   per phase: total(varint) max(varint) first count, then count buckets
+//              from bucket first on as varints
+//   worstCount, then per frame: frame(varint) and the time of each
+//              phase(varint)
+class Profiler {
+private:
+  GameProfile games[MAX_GAMES];
+  int game;                 // Game the frames belong to, -1 for none
+  uint8_t phase;            // Phase being timed, PROFILE_PHASES outside all scopes
+  unsigned long phaseStart;
+  uint32_t frameMicros[PROFILE_PHASES];  // Time of the frame so far
+  
+  void charge(unsigned long now);
+  void keepIfWorst(GameProfile& profile);
+  
+public:
+  Profiler();
+  void setGame(int gameId);
+  void resetStats(int gameId);  // A new game starts, its old frames go
+  uint8_t enter(uint8_t newPhase);
+  void leave(uint8_t parent);
+  void endFrame();
+  void printStats(int gameId);
+  void dump(int gameId);
+};
+
+extern Profiler profiler;
+
+// Times the rest of the enclosing block as one phase
+class ProfileScope {
+private:
+  uint8_t parent;
+  
+public:
+  ProfileScope(uint8_t phase) : parent(profiler.enter(phase)) {}
+  ~ProfileScope() { profiler.leave(parent); }
+};
+
+#define PROFILE_SCOPE(phase) ProfileScope profileScope(phase)
+#define PROFILE_END_FRAME() profiler.endFrame()
+#else
+#define PROFILE_SCOPE(phase)
+#define PROFILE_END_FRAME()
+#endif
+
+#endif
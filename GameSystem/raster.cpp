@@ -0,0 +1,225 @@
+#include "raster.h"
+
+// Row masks within a page: rows from n down, rows up to n
+static const uint8_t fromRowMask[8] = {0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80};
+static const uint8_t toRowMask[8] = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF};
+
+template <uint16_t COLOR, typename T>
+static inline void applyMask(T& dst, T mask) {
+  if (COLOR == SSD1306_WHITE) dst |= mask;
+  else if (COLOR == SSD1306_BLACK) dst &= ~mask;
+  else dst ^= mask;
+}
+
+// Applies one mask to a run of columns, 4 columns per write once aligned
+template <uint16_t COLOR>
+static void span(uint8_t* dst, uint8_t count, uint8_t mask) {
+  while (count > 0 && ((uintptr_t)dst & 3)) {
+    applyMask<COLOR, uint8_t>(*dst++, mask);
+    count--;
+  }
+  
+  uint32_t wideMask = mask * 0x01010101UL;
+  uint32_t* words = (uint32_t*)dst;
+  for (; count >= 4; count -= 4) {
+    applyMask<COLOR, uint32_t>(*words++, wideMask);
+  }
+  
+  dst = (uint8_t*)words;
+  while (count > 0) {
+    applyMask<COLOR, uint8_t>(*dst++, mask);
+    count--;
+  }
+}
+
+static void spanColor(uint8_t* dst, uint8_t count, uint8_t mask, uint16_t color) {
+  switch (color) {
+    case SSD1306_WHITE:
+      span<SSD1306_WHITE>(dst, count, mask);
+      break;
+    case SSD1306_BLACK:
+      span<SSD1306_BLACK>(dst, count, mask);
+      break;
+    case SSD1306_INVERSE:
+      span<SSD1306_INVERSE>(dst, count, mask);
+      break;
+  }
+}
+
+void rasterFillRect(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                    int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  int top = max((int)y, firstPage * 8);
+  int bottom = min(y + h, (lastPage + 1) * 8) - 1;
+  int left = max((int)x, 0);
+  int right = min(x + w, SCREEN_WIDTH);
+  if (top > bottom || left >= right) return;
+  
+  uint8_t topPage = top >> 3;
+  uint8_t bottomPage = bottom >> 3;
+  uint8_t* row = buffer + (topPage - firstPage) * SCREEN_WIDTH + left;
+  
+  for (uint8_t page = topPage; page <= bottomPage; page++) {
+    uint8_t mask = 0xFF;
+    if (page == topPage) mask &= fromRowMask[top & 7];
+    if (page == bottomPage) mask &= toRowMask[bottom & 7];
+    
+    spanColor(row, right - left, mask, color);
+    row += SCREEN_WIDTH;
+  }
+}
+
+void rasterHLine(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (y < firstPage * 8 || y >= (lastPage + 1) * 8) return;
+  int left = max((int)x, 0);
+  int right = min(x + w, SCREEN_WIDTH);
+  if (left >= right) return;
+  
+  uint8_t* row = buffer + ((y >> 3) - firstPage) * SCREEN_WIDTH + left;
+  spanColor(row, right - left, 1 << (y & 7), color);
+}
+
+void rasterVLine(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (x < 0 || x >= SCREEN_WIDTH) return;
+  int top = max((int)y, firstPage * 8);
+  int bottom = min(y + h, (lastPage + 1) * 8) - 1;
+  if (top > bottom) return;
+  
+  uint8_t topPage = top >> 3;
+  uint8_t bottomPage = bottom >> 3;
+  uint8_t* column = buffer + (topPage - firstPage) * SCREEN_WIDTH + x;
+  
+  // One byte per page, no span setup
+  for (uint8_t page = topPage; page <= bottomPage; page++) {
+    uint8_t mask = 0xFF;
+    if (page == topPage) mask &= fromRowMask[top & 7];
+    if (page == bottomPage) mask &= toRowMask[bottom & 7];
+    
+    switch (color) {
+      case SSD1306_WHITE:
+        *column |= mask;
+        break;
+      case SSD1306_BLACK:
+        *column &= ~mask;
+        break;
+      case SSD1306_INVERSE:
+        *column ^= mask;
+        break;
+    }
+    column += SCREEN_WIDTH;
+  }
+}
+
+void rasterSprite(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                  int16_t x, int16_t y, const Sprite& sprite) {
+  int16_t left = x - sprite.originX;
+  int16_t top = y - sprite.originY;
+  if (top <= -8 || top >= SCREEN_HEIGHT) return;
+  
+  int16_t firstColumn = max(0, -left);
+  int16_t lastColumn = min((int)sprite.width, SCREEN_WIDTH - left) - 1;
+  if (firstColumn > lastColumn) return;
+  
+  // The sprite rows land in one page, or two when not page aligned
+  int16_t page = (top + 8) / 8 - 1;
+  uint8_t shift = top - page * 8;
+  uint8_t* upper = NULL;
+  uint8_t* lower = NULL;
+  if (page >= firstPage && page <= lastPage) {
+    upper = buffer + (page - firstPage) * SCREEN_WIDTH + left;
+  }
+  if (shift > 0 && page + 1 >= firstPage && page + 1 <= lastPage) {
+    lower = buffer + (page + 1 - firstPage) * SCREEN_WIDTH + left;
+  }
+  
+  const uint8_t* data = sprite.data + firstColumn * 2;
+  for (int16_t i = firstColumn; i <= lastColumn; i++) {
+    uint16_t bits = pgm_read_byte(data++) << shift;
+    uint16_t mask = pgm_read_byte(data++) << shift;
+    if (upper) upper[i] = (upper[i] & ~mask) | bits;
+    if (lower) lower[i] = (lower[i] & ~(mask >> 8)) | (bits >> 8);
+  }
+}
+
+void rasterGlyph(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, const uint8_t* columns, uint8_t width, uint16_t color) {
+  if (y <= -8 || y >= SCREEN_HEIGHT) return;
+  
+  int16_t firstColumn = max(0, -x);
+  int16_t lastColumn = min((int)width, SCREEN_WIDTH - x) - 1;
+  if (firstColumn > lastColumn) return;
+  
+  int16_t page = (y + 8) / 8 - 1;
+  uint8_t shift = y - page * 8;
+  uint8_t* upper = NULL;
+  uint8_t* lower = NULL;
+  if (page >= firstPage && page <= lastPage) {
+    upper = buffer + (page - firstPage) * SCREEN_WIDTH + x;
+  }
+  if (shift > 0 && page + 1 >= firstPage && page + 1 <= lastPage) {
+    lower = buffer + (page + 1 - firstPage) * SCREEN_WIDTH + x;
+  }
+  
+  for (int16_t i = firstColumn; i <= lastColumn; i++) {
+    uint16_t bits = columns[i] << shift;
+    switch (color) {
+      case SSD1306_WHITE:
+        if (upper) upper[i] |= bits;
+        if (lower) lower[i] |= bits >> 8;
+        break;
+      case SSD1306_BLACK:
+        if (upper) upper[i] &= ~bits;
+        if (lower) lower[i] &= ~(bits >> 8);
+        break;
+      case SSD1306_INVERSE:
+        if (upper) upper[i] ^= bits;
+        if (lower) lower[i] ^= bits >> 8;
+        break;
+    }
+  }
+}
+
+void rasterAsset(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, const Asset& asset) {
+  AssetStream stream(asset);
+  uint8_t pages = (asset.height + 7) / 8;
+  
+  int16_t firstColumn = max(0, -x);
+  int16_t lastColumn = min((int)asset.width, SCREEN_WIDTH - x) - 1;
+  if (firstColumn > lastColumn) return;
+  
+  for (uint8_t assetPage = 0; assetPage < pages; assetPage++) {
+    // Each asset page lands in one screen page, or two when not aligned
+    int16_t top = y + assetPage * 8;
+    if (top >= SCREEN_HEIGHT) break;
+    if (top <= -8) {
+      stream.skip(asset.width);
+      continue;
+    }
+    
+    int16_t page = (top + 8) / 8 - 1;
+    uint8_t shift = top - page * 8;
+    uint8_t* upper = NULL;
+    uint8_t* lower = NULL;
+    if (page >= firstPage && page <= lastPage) {
+      upper = buffer + (page - firstPage) * SCREEN_WIDTH + x;
+    }
+    if (shift > 0 && page + 1 >= firstPage && page + 1 <= lastPage) {
+      lower = buffer + (page + 1 - firstPage) * SCREEN_WIDTH + x;
+    }
+    
+    if (!upper && !lower) {
+      stream.skip(asset.width);
+      continue;
+    }
+    
+    stream.skip(firstColumn);
+    for (int16_t i = firstColumn; i <= lastColumn; i++) {
+      uint16_t bits = stream.next() << shift;
+      if (upper) upper[i] |= bits;
+      if (lower) lower[i] |= bits >> 8;
+    }
+    stream.skip(asset.width - 1 - lastColumn);
+  }
+}
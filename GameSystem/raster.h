@@ -0,0 +1,32 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "config.h"
+#include "sprites.h"
+#include "assets.h"
+
+// Fill kernels for the SSD1306 page layout. `buffer` holds pages
+// firstPage..lastPage, SCREEN_WIDTH bytes each, one bit per row.
+// Everything outside the screen width and those pages is clipped.
+// SSD1306_INVERSE fills with XOR.
+void rasterFillRect(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                    int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void rasterHLine(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, int16_t w, uint16_t color);
+void rasterVLine(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, int16_t h, uint16_t color);
+
+// Masked sprite blit, x and y are the sprite's anchor
+void rasterSprite(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                  int16_t x, int16_t y, const Sprite& sprite);
+
+// Built-in font glyph, one byte per column with bit 0 the top row.
+// Only set bits are drawn, like text with no background color.
+void rasterGlyph(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, const uint8_t* columns, uint8_t width, uint16_t color);
+
+// Streams a packed asset into the pages it covers, x and y its top left
+void rasterAsset(uint8_t* buffer, uint8_t firstPage, uint8_t lastPage,
+                 int16_t x, int16_t y, const Asset& asset);
+
+#endif
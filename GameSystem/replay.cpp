@@ -0,0 +1,234 @@
+#include "replay.h"
+
+#define REPLAY_VERSION 1
+#define REPLAY_HEADER_SIZE 7
+
+InputReplay inputReplay;
+static uint32_t randomState = 1;
+
+static uint16_t packInput(const ButtonMasks& masks) {
+  return masks.current | masks.pressed << 4 | masks.repeat << 8 | masks.released << 12;
+}
+
+static uint32_t zigzag(long value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static long unzigzag(uint32_t value) {
+  return (long)(value >> 1) ^ -(long)(value & 1);
+}
+
+bool InputReplay::writeByte(uint8_t value) {
+  if (length >= REPLAY_BUFFER_SIZE) return false;
+  data[length++] = value;
+  return true;
+}
+
+bool InputReplay::writeVarint(uint32_t value) {
+  // Seven bits per byte, low bits first, top bit set while more follow
+  while (value >= 0x80) {
+    if (!writeByte((value & 0x7F) | 0x80)) return false;
+    value >>= 7;
+  }
+  return writeByte(value);
+}
+
+bool InputReplay::readByte(uint8_t& value) {
+  if (position >= length) return false;
+  value = data[position++];
+  return true;
+}
+
+bool InputReplay::readVarint(uint32_t& value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 32; shift += 7) {
+    uint8_t b;
+    if (!readByte(b)) return false;
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+bool InputReplay::writeRun() {
+  uint16_t start = length;
+  bool inputChanged = runInput != streamInput;
+  bool deltaChanged = runDelta != streamDelta;
+  
+  bool written = writeVarint((uint32_t)runFrames << 2 | inputChanged << 1 | deltaChanged);
+  if (written && inputChanged) written = writeByte(runInput) && writeByte(runInput >> 8);
+  if (written && deltaChanged) written = writeVarint(zigzag(runDelta - streamDelta));
+  if (!written) {
+    // Keep the stream readable up to the last whole run
+    length = start;
+    return false;
+  }
+  
+  streamInput = runInput;
+  streamDelta = runDelta;
+  runFrames = 0;
+  return true;
+}
+
+void InputReplay::startRecording(uint32_t seed) {
+  length = 0;
+  full = false;
+  frames = 0;
+  streamInput = 0;
+  streamDelta = 0;
+  runFrames = 0;
+  
+  writeByte('I');
+  writeByte('R');
+  writeByte(REPLAY_VERSION);
+  for (uint8_t i = 0; i < 4; i++) {
+    writeByte(seed >> (i * 8));
+  }
+  mode = REPLAY_RECORDING;
+}
+
+void InputReplay::recordFrame(const ButtonMasks& masks, unsigned long time) {
+  if (mode != REPLAY_RECORDING) return;
+  
+  if (frames == 0) {
+    writeVarint(time);
+    lastTime = time;
+  }
+  
+  uint16_t input = packInput(masks);
+  long delta = time - lastTime;
+  lastTime = time;
+  frames++;
+  
+  if (runFrames > 0 && input == runInput && delta == runDelta) {
+    runFrames++;
+    return;
+  }
+  
+  if (runFrames > 0 && !writeRun()) {
+    mode = REPLAY_IDLE;
+    full = true;
+    return;
+  }
+  runInput = input;
+  runDelta = delta;
+  runFrames = 1;
+}
+
+void InputReplay::finish() {
+  if (mode == REPLAY_RECORDING && runFrames > 0 && !writeRun()) {
+    mode = REPLAY_IDLE;
+    full = true;
+  }
+}
+
+bool InputReplay::load(const uint8_t* source, uint16_t size) {
+  if (size < REPLAY_HEADER_SIZE || size > REPLAY_BUFFER_SIZE ||
+      source[0] != 'I' || source[1] != 'R' || source[2] != REPLAY_VERSION) {
+    return false;
+  }
+  
+  memcpy(data, source, size);
+  length = size;
+  position = REPLAY_HEADER_SIZE;
+  uint32_t time;
+  if (!readVarint(time)) return false;
+  
+  lastTime = time;
+  streamInput = 0;
+  streamDelta = 0;
+  runFrames = 0;
+  frames = 0;
+  full = false;
+  mode = REPLAY_PLAYING;
+  return true;
+}
+
+bool InputReplay::playFrame(ButtonMasks& masks, unsigned long& time) {
+  if (mode != REPLAY_PLAYING) return false;
+  
+  if (runFrames == 0) {
+    uint32_t header;
+    uint8_t low, high;
+    uint32_t change;
+    bool valid = readVarint(header) && header >> 2 != 0;
+    if (valid && (header & 2)) {
+      valid = readByte(low) && readByte(high);
+      if (valid) streamInput = low | high << 8;
+    }
+    if (valid && (header & 1)) {
+      valid = readVarint(change);
+      if (valid) streamDelta += unzigzag(change);
+    }
+    if (!valid) {
+      // End of the recording, the buttons take over again
+      mode = REPLAY_IDLE;
+      return false;
+    }
+    runFrames = header >> 2;
+  }
+  
+  runFrames--;
+  frames++;
+  lastTime += streamDelta;
+  time = lastTime;
+  masks.current = streamInput & 0x0F;
+  masks.pressed = (streamInput >> 4) & 0x0F;
+  masks.repeat = (streamInput >> 8) & 0x0F;
+  masks.released = streamInput >> 12;
+  return true;
+}
+
+uint32_t InputReplay::getSeed() {
+  if (length < REPLAY_HEADER_SIZE) return 0;
+  return data[3] | (uint32_t)data[4] << 8 | (uint32_t)data[5] << 16 | (uint32_t)data[6] << 24;
+}
+
+void InputReplay::print() {
+  finish();
+  if (length == 0) return;
+  
+  Serial.print(F("Replay: "));
+  Serial.print(length);
+  Serial.print(F(" bytes, "));
+  Serial.print(frames);
+  Serial.println(full ? F(" frames, buffer full") : F(" frames"));
+  
+  // Hex lines that can be pasted into a file for load()
+  for (uint16_t i = 0; i < length; i++) {
+    if (data[i] < 0x10) Serial.print('0');
+    Serial.print(data[i], HEX);
+    if (i % 32 == 31 || i == length - 1) Serial.println();
+  }
+}
+
+void initReplay() {
+  if (inputReplay.getMode() == REPLAY_PLAYING) {
+    seedGameRandom(inputReplay.getSeed());
+    return;
+  }
+  
+#ifdef ESP32
+  uint32_t seed = esp_random();
+#else
+  uint32_t seed = micros();
+#endif
+  seedGameRandom(seed);
+#if RECORD_INPUT
+  inputReplay.startRecording(seed);
+#endif
+}
+
+void seedGameRandom(uint32_t seed) {
+  randomState = seed ? seed : 1;
+}
+
+long gameRandom(long min, long max) {
+  if (min >= max) return min;
+  
+  // xorshift32
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return min + (long)(randomState % (uint32_t)(max - min));
+}
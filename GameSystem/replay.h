@@ -0,0 +1,75 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "config.h"
+#include "input.h"
+
+enum ReplayMode {
+  REPLAY_IDLE,
+  REPLAY_RECORDING,
+  REPLAY_PLAYING
+};
+
+// The input every frame saw, kept so a session can be played back exactly.
+// A recording starts with a header holding the random seed and the time
+// of the first frame:
+//
+//   'I' 'R' version seed(4 bytes, little endian) time(varint)
+//
+// followed by runs of identical frames. Each run is a varint
+// (frames << 2 | inputChanged << 1 | deltaChanged), then the new input as
+// two bytes (current | pressed << 4, repeat | released << 4) if it changed
+// and the change of the frame time delta as a zigzag varint if that changed.
+// A steady frame period with no button changes costs one byte per run.
+class InputReplay {
+private:
+  uint8_t data[REPLAY_BUFFER_SIZE];
+  uint16_t length;    // Bytes of data in use
+  uint16_t position;  // Read position when playing
+  ReplayMode mode;
+  bool full;          // Recording stopped because the buffer ran out
+  unsigned long frames;
+  
+  // Input and delta of the last run in the stream
+  uint16_t streamInput;
+  long streamDelta;
+  // Run being recorded, or the frames left of the run being played
+  uint16_t runInput;
+  long runDelta;
+  unsigned long runFrames;
+  unsigned long lastTime;
+  
+  bool writeByte(uint8_t value);
+  bool writeVarint(uint32_t value);
+  bool readByte(uint8_t& value);
+  bool readVarint(uint32_t& value);
+  bool writeRun();
+  
+public:
+  InputReplay() : length(0), position(0), mode(REPLAY_IDLE), full(false), frames(0) {}
+  void startRecording(uint32_t seed);
+  void recordFrame(const ButtonMasks& masks, unsigned long time);
+  void finish();
+  bool load(const uint8_t* source, uint16_t size);
+  bool playFrame(ButtonMasks& masks, unsigned long& time);
+  uint32_t getSeed();
+  ReplayMode getMode() { return mode; }
+  bool isFull() { return full; }
+  unsigned long getFrames() { return frames; }
+  const uint8_t* getData() { return data; }
+  uint16_t getSize() { return length; }
+  void print();
+};
+
+extern InputReplay inputReplay;
+
+// Seeds the game random numbers for this session, from the recording when
+// one was loaded, and starts recording when RECORD_INPUT is set
+void initReplay();
+
+// Random numbers for the games. Unlike random() on ESP32, which draws from
+// the hardware generator, the sequence follows from the seed.
+void seedGameRandom(uint32_t seed);
+long gameRandom(long min, long max);
+
+#endif
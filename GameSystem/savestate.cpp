@@ -0,0 +1,196 @@
+#include "savestate.h"
+#include "gamearena.h"
+#include "highscore.h"
+#include "frameclock.h"
+#include "logger.h"
+
+SaveState saveState;
+
+static_assert(sizeof(HighscoreData) <= SAVE_STATE_ADDR, "save state overlaps the highscores");
+static_assert(SAVE_STATE_ADDR + SAVE_STATE_SIZE <= EEPROM_SIZE, "save state does not fit the EEPROM");
+
+SaveStream::SaveStream(uint8_t* data, uint16_t size, bool loading)
+  : data(data), size(size), position(0), loading(loading), failed(false), now(frameClock.now()) {}
+
+void SaveStream::varint(long& value) {
+  if (loading) {
+    // Seven bits per byte, low bits first, then the sign back from the low bit
+    unsigned long bits = 0;
+    for (uint8_t shift = 0; shift < sizeof(bits) * 8; shift += 7) {
+      if (position >= size) {
+        failed = true;
+        return;
+      }
+      uint8_t b = data[position++];
+      bits |= (unsigned long)(b & 0x7F) << shift;
+      if (!(b & 0x80)) break;
+    }
+    value = (bits & 1) ? ~(long)(bits >> 1) : (long)(bits >> 1);
+    return;
+  }
+  
+  // Zigzag: the sign goes to the low bit, so small negatives stay short
+  unsigned long bits = (value < 0) ? ~(unsigned long)value << 1 | 1 : (unsigned long)value << 1;
+  do {
+    uint8_t b = bits & 0x7F;
+    bits >>= 7;
+    if (bits) b |= 0x80;
+    if (position >= size) {
+      failed = true;
+      return;
+    }
+    data[position++] = b;
+  } while (bits);
+}
+
+void SaveStream::value(int& value) {
+  long wide = value;
+  varint(wide);
+  value = wide;
+}
+
+void SaveStream::value(long& value) {
+  varint(value);
+}
+
+void SaveStream::value(unsigned long& value) {
+  long wide = value;
+  varint(wide);
+  value = wide;
+}
+
+void SaveStream::value(bool& value) {
+  long wide = value;
+  varint(wide);
+  value = wide != 0;
+}
+
+void SaveStream::value(Fixed& value) {
+  long raw = value.getRaw();
+  varint(raw);
+  value = Fixed::fromRaw(raw);
+}
+
+void SaveStream::time(unsigned long& value) {
+  long offset = (long)(value - now);
+  varint(offset);
+  value = now + offset;
+}
+
+void SaveStream::bytes(void* values, uint16_t length) {
+  if (position + length > size) {
+    failed = true;
+    return;
+  }
+  if (loading) {
+    memcpy(values, data + position, length);
+  } else {
+    memcpy(data + position, values, length);
+  }
+  position += length;
+}
+
+void SaveStream::count(int& value, int limit) {
+  this->value(value);
+  if (value < 0 || value > limit) {
+    value = 0;
+    failed = true;
+  }
+}
+
+uint16_t SaveState::checksum(uint16_t end) {
+  uint16_t sum = 0;
+  for (uint16_t i = 0; i < end; i++) sum += blob[i];
+  return sum;
+}
+
+bool SaveState::isValid(uint16_t size) {
+  if (size < SAVE_STATE_HEADER + 2) return false;
+  if (blob[0] != 'S' || blob[1] != 'V' || blob[2] != SAVE_STATE_VERSION) return false;
+  
+  uint16_t payload = blob[4] | blob[5] << 8;
+  uint16_t end = SAVE_STATE_HEADER + payload;
+  if (end + 2 > size) return false;
+  if ((blob[end] | blob[end + 1] << 8) != checksum(end)) return false;
+  return GameRegistry::indexOf(blob[3]) >= 0;
+}
+
+bool SaveState::suspend() {
+  const GameEntry* game = gameArena.getGame();
+  if (!game) return false;
+  
+  unsigned long start = micros();
+  SaveStream stream(blob + SAVE_STATE_HEADER, SAVE_STATE_SIZE - SAVE_STATE_HEADER - 2, false);
+  game->serialize(gameArena.getData(), stream);
+  if (!stream.ok()) {
+    LOG_ERROR("Save state of game %d does not fit", game->id);
+    discard();
+    return false;
+  }
+  
+  uint16_t payload = stream.getLength();
+  uint16_t end = SAVE_STATE_HEADER + payload;
+  blob[0] = 'S';
+  blob[1] = 'V';
+  blob[2] = SAVE_STATE_VERSION;
+  blob[3] = game->id;
+  blob[4] = payload & 0xFF;
+  blob[5] = payload >> 8;
+  uint16_t sum = checksum(end);
+  blob[end] = sum & 0xFF;
+  blob[end + 1] = sum >> 8;
+  length = end + 2;
+  unsigned long captured = micros() - start;
+  
+  EEPROM.writeBytes(SAVE_STATE_ADDR, blob, length);
+  EEPROM.commit();
+  stored = true;
+  
+  LOG_INFO("Game %d suspended: %u bytes in %u us", game->id, length, captured);
+  return true;
+}
+
+bool SaveState::resume() {
+  if (length == 0) return false;
+  
+  // The game starts fresh and the stream overwrites what init() set up
+  unsigned long start = micros();
+  const GameEntry& game = GameRegistry::games[GameRegistry::indexOf(blob[3])];
+  gameArena.start(game);
+  game.init(gameArena.getData());
+  uint16_t payload = blob[4] | blob[5] << 8;
+  SaveStream stream(blob + SAVE_STATE_HEADER, payload, true);
+  game.serialize(gameArena.getData(), stream);
+  if (!stream.ok() || stream.getLength() != payload) {
+    LOG_ERROR("Save state of game %d is damaged", game.id);
+    gameArena.stop();
+    discard();
+    return false;
+  }
+  
+  LOG_INFO("Game %d resumed in %u us", game.id, micros() - start);
+  return true;
+}
+
+bool SaveState::loadStored() {
+  EEPROM.readBytes(SAVE_STATE_ADDR, blob, SAVE_STATE_SIZE);
+  if (!isValid(SAVE_STATE_SIZE)) {
+    length = 0;
+    stored = false;
+    return false;
+  }
+  
+  length = SAVE_STATE_HEADER + (blob[4] | blob[5] << 8) + 2;
+  stored = true;
+  return true;
+}
+
+void SaveState::discard() {
+  length = 0;
+  if (!stored) return;
+  
+  // A broken header is enough to invalidate it
+  EEPROM.write(SAVE_STATE_ADDR, 0);
+  EEPROM.commit();
+  stored = false;
+}
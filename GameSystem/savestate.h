@@ -0,0 +1,72 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include "config.h"
+#include "fixed.h"
+
+#define SAVE_STATE_VERSION 1
+#define SAVE_STATE_ADDR 64     // EEPROM address, after the highscores
+#define SAVE_STATE_SIZE 448    // Largest blob, also its space in EEPROM
+#define SAVE_STATE_HEADER 6
+
+// One pass over a game's state that either writes it into a blob or reads
+// it back, so a game's save and load cannot drift apart. Numbers are zigzag
+// varints, small ones take a byte. Times are stored as their distance to
+// the game clock and come back relative to the clock at load, so timers
+// carry on as they were after a pause or a reboot.
+class SaveStream {
+private:
+  uint8_t* data;
+  uint16_t size;
+  uint16_t position;
+  bool loading;
+  bool failed;
+  unsigned long now;
+  
+  void varint(long& value);
+  
+public:
+  SaveStream(uint8_t* data, uint16_t size, bool loading);
+  bool isLoading() { return loading; }
+  bool ok() { return !failed; }
+  uint16_t getLength() { return position; }
+  void fail() { failed = true; }
+  
+  void value(int& value);
+  void value(long& value);
+  void value(unsigned long& value);
+  void value(bool& value);
+  void value(Fixed& value);
+  void time(unsigned long& value);
+  void bytes(void* values, uint16_t length);
+  void count(int& value, int limit);  // A length that sizes a loop, checked on load
+};
+
+// The suspended game, kept in RAM and in flash. The blob is
+//
+//   'S' 'V' version game length(2) payload checksum(2)
+//
+// with the payload written by the game's serialize(). A blob from another
+// version or with a bad checksum is ignored.
+class SaveState {
+private:
+  uint8_t blob[SAVE_STATE_SIZE];
+  uint16_t length;  // Blob size, 0 when no game is suspended
+  bool stored;      // Flash holds the blob
+  
+  uint16_t checksum(uint16_t end);
+  bool isValid(uint16_t size);
+  
+public:
+  SaveState() : length(0), stored(false) {}
+  bool suspend();
+  bool resume();
+  bool loadStored();
+  void discard();
+  bool hasGame() { return length > 0; }
+  int getGame() { return length > 0 ? blob[3] : -1; }
+};
+
+extern SaveState saveState;
+
+#endif
@@ -0,0 +1,101 @@
+#include "scrolllayer.h"
+#include "raster.h"
+
+ScrollLayer scrollLayer;
+
+void ScrollLayer::reset() {
+  origin = 0;
+  valid = false;
+  dirtyLeft = 0;
+  dirtyRight = -1;
+  clipLeft = 0;
+  clipRight = -1;
+}
+
+void ScrollLayer::scrollTo(long newOrigin) {
+  if (!valid || newOrigin < origin || newOrigin - origin >= SCREEN_WIDTH) {
+    // Nothing in the ring can be reused
+    origin = newOrigin;
+    valid = true;
+    dirtyLeft = origin;
+    dirtyRight = origin + SCREEN_WIDTH - 1;
+    return;
+  }
+  
+  long exposedLeft = origin + SCREEN_WIDTH;
+  origin = newOrigin;
+  markDirty(exposedLeft, origin + SCREEN_WIDTH - 1);
+}
+
+void ScrollLayer::markDirty(long left, long right) {
+  // Only columns inside the window are kept
+  left = max(left, origin);
+  right = min(right, origin + SCREEN_WIDTH - 1);
+  if (left > right) return;
+  
+  if (dirtyLeft > dirtyRight) {
+    dirtyLeft = left;
+    dirtyRight = right;
+  } else {
+    dirtyLeft = min(dirtyLeft, left);
+    dirtyRight = max(dirtyRight, right);
+  }
+}
+
+bool ScrollLayer::beginRender() {
+  // Dirty columns left of the window scrolled out before being drawn
+  dirtyLeft = max(dirtyLeft, origin);
+  if (dirtyLeft > dirtyRight) return false;
+  
+  clipLeft = dirtyLeft;
+  clipRight = dirtyRight;
+  dirtyLeft = 0;
+  dirtyRight = -1;
+  
+  fillColumns(clipLeft, clipRight, 0, SCREEN_HEIGHT, SSD1306_BLACK);
+  return true;
+}
+
+void ScrollLayer::fillRect(long x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  long left = max(x, clipLeft);
+  long right = min(x + w - 1, clipRight);
+  if (left > right) return;
+  
+  fillColumns(left, right, y, h, color);
+}
+
+void ScrollLayer::fillColumns(long left, long right, int16_t y, int16_t h, uint16_t color) {
+#if SCROLL_LAYER_ENABLED
+  // The range is at most one window wide, so it wraps the ring at most once
+  int16_t start = left & (SCREEN_WIDTH - 1);
+  int16_t count = right - left + 1;
+  int16_t beforeWrap = min(count, (int16_t)(SCREEN_WIDTH - start));
+  
+  rasterFillRect(ring, 0, DISPLAY_PAGES - 1, start, y, beforeWrap, h, color);
+  if (count > beforeWrap) {
+    rasterFillRect(ring, 0, DISPLAY_PAGES - 1, 0, y, count - beforeWrap, h, color);
+  }
+#endif
+}
+
+void ScrollLayer::blit(uint8_t* target, bool merge) {
+#if SCROLL_LAYER_ENABLED
+  // Two runs per page, split where the window wraps the ring
+  uint8_t start = origin & (SCREEN_WIDTH - 1);
+  uint8_t beforeWrap = SCREEN_WIDTH - start;
+  
+  for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+    const uint8_t* row = ring + page * SCREEN_WIDTH;
+    
+    if (merge) {
+      // OR over what is already in the frame
+      for (uint8_t i = 0; i < beforeWrap; i++) target[i] |= row[start + i];
+      for (uint8_t i = 0; i < start; i++) target[beforeWrap + i] |= row[i];
+    } else {
+      memcpy(target, row + start, beforeWrap);
+      memcpy(target + beforeWrap, row, start);
+    }
+    target += SCREEN_WIDTH;
+  }
+#endif
+}
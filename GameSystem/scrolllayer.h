@@ -0,0 +1,46 @@
+#ifndef SCROLLLAYER_H
+#define SCROLLLAYER_H
+
+#include "config.h"
+#include "display.h"
+
+#if USE_SCROLL_LAYER && !DISPLAY_PAGED
+#define SCROLL_LAYER_ENABLED 1
+#else
+#define SCROLL_LAYER_ENABLED 0
+#endif
+
+#if SCROLL_LAYER_ENABLED && (SCREEN_WIDTH & (SCREEN_WIDTH - 1))
+#error "Scroll layer needs a power of two SCREEN_WIDTH"
+#endif
+
+// Horizontally scrolling background kept in a ring buffer. World column c is
+// stored at column c % SCREEN_WIDTH, so moving the window only leaves the
+// newly exposed columns to be drawn. Coordinates are world columns.
+class ScrollLayer {
+private:
+#if SCROLL_LAYER_ENABLED
+  uint8_t ring[DISPLAY_BUFFER_SIZE];
+#endif
+  long origin;      // World column shown at screen column 0
+  bool valid;       // False until the whole window has been drawn once
+  long dirtyLeft;   // Columns waiting to be drawn, empty when left > right
+  long dirtyRight;
+  long clipLeft;    // Columns open for drawing since beginRender()
+  long clipRight;
+  
+  void fillColumns(long left, long right, int16_t y, int16_t h, uint16_t color);
+  
+public:
+  void reset();
+  void scrollTo(long newOrigin);
+  void markDirty(long left, long right);
+  bool beginRender();
+  void fillRect(long x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void blit(uint8_t* target, bool merge);
+  long getOrigin() { return origin; }
+};
+
+extern ScrollLayer scrollLayer;
+
+#endif
@@ -1,8 +1,8 @@
 #include "snake.h"
 #include "display.h"
 #include "input.h"
-
-SnakeGame snakeGame;
+#include "frameclock.h"
+#include "replay.h"
 
 void SnakeGame::init() {
   snakeLength = 3;
@@ -16,6 +16,7 @@ void SnakeGame::init() {
   score = 0;
   gameSpeed = 300;
   gameOver = false;
+  frameVersion = 0;
   lastMoveTime = 0;
   
   generateFood();
@@ -24,7 +25,7 @@ void SnakeGame::init() {
 void SnakeGame::update() {
   handleInput();
   
-  if (millis() - lastMoveTime > gameSpeed) {
+  if (frameClock.now() - lastMoveTime > gameSpeed) {
     direction = nextDirection;
     directionChanged = false;
     
@@ -32,7 +33,8 @@ void SnakeGame::update() {
     if (checkCollisions()) {
       gameOver = true;
     }
-    lastMoveTime = millis();
+    lastMoveTime = frameClock.now();
+    frameVersion++;
   }
 }
 
@@ -54,7 +56,7 @@ void SnakeGame::draw() {
   // Draw food
   int foodX = food.x * GRID_SIZE;
   int foodY = food.y * GRID_SIZE;
-  display.fillCircle(foodX + GRID_SIZE/2, foodY + GRID_SIZE/2, GRID_SIZE/2-1, SSD1306_WHITE);
+  display.drawSprite(spriteDot, foodX + GRID_SIZE/2, foodY + GRID_SIZE/2);
   
   // Draw score - avoid food area
   display.setTextSize(1);
@@ -67,7 +69,7 @@ void SnakeGame::draw() {
   }
   
   display.print(F("Score: "));
-  display.print(score);
+  display.printNumber(score);
   
   updateDisplay();
 }
@@ -99,8 +101,8 @@ void SnakeGame::generateFood() {
   bool validPosition = false;
   
   while (!validPosition) {
-    food.x = random(0, GRID_WIDTH);
-    food.y = random(0, GRID_HEIGHT);
+    food.x = gameRandom(0, GRID_WIDTH);
+    food.y = gameRandom(0, GRID_HEIGHT);
     
     validPosition = true;
     for (int i = 0; i < snakeLength; i++) {
@@ -148,7 +150,12 @@ bool SnakeGame::checkCollisions() {
   // Food collision
   if (head.x == food.x && head.y == food.y) {
     score++;
-    snakeLength++;
+    
+    // The new tail starts on the old one, not on whatever the slot held
+    if (snakeLength < MAX_SNAKE_LENGTH) {
+      snake[snakeLength] = snake[snakeLength - 1];
+      snakeLength++;
+    }
     
     if (gameSpeed > 100) {
       gameSpeed -= 10;
@@ -158,4 +165,21 @@ bool SnakeGame::checkCollisions() {
   }
   
   return false;
-}
\ No newline at end of file
+}
+
+void SnakeGame::serialize(SaveStream& state) {
+  state.count(snakeLength, MAX_SNAKE_LENGTH);
+  for (int i = 0; i < snakeLength; i++) {
+    state.value(snake[i].x);
+    state.value(snake[i].y);
+  }
+  state.value(food.x);
+  state.value(food.y);
+  state.value(direction);
+  state.value(nextDirection);
+  state.value(directionChanged);
+  state.value(score);
+  state.time(lastMoveTime);
+  state.value(gameSpeed);
+  state.value(gameOver);
+}
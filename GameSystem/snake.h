@@ -2,6 +2,7 @@
 #define SNAKE_H
 
 #include "config.h"
+#include "savestate.h"
 
 #define GRID_SIZE 4
 #define GRID_WIDTH (SCREEN_WIDTH / GRID_SIZE)
@@ -24,6 +25,7 @@ private:
   unsigned long lastMoveTime;
   int gameSpeed;
   bool gameOver;
+  unsigned long frameVersion;
   
   void generateFood();
   void moveSnake();
@@ -34,11 +36,12 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  bool isGameWon() { return false; }
+  unsigned long getFrameVersion() { return frameVersion; }
   int getScore() { return score; }
   const char* getName() { return "SNAKE"; }
 };
 
-extern SnakeGame snakeGame;
-
 #endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+// Generated by tools/make_sprites.py, do not edit
+#include "sprites.h"
+
+const uint8_t pacmanRightData[] PROGMEM = {0x1C, 0x1C, 0x3E, 0x3E, 0x7F, 0x7F, 0x77, 0x7F, 0x77, 0x7F, 0x2A, 0x3E, 0x1C, 0x1C};
+const uint8_t pacmanDownData[] PROGMEM = {0x1C, 0x1C, 0x3E, 0x3E, 0x5F, 0x7F, 0x67, 0x7F, 0x5F, 0x7F, 0x3E, 0x3E, 0x1C, 0x1C};
+const uint8_t pacmanLeftData[] PROGMEM = {0x1C, 0x1C, 0x2A, 0x3E, 0x6B, 0x7F, 0x77, 0x7F, 0x7F, 0x7F, 0x3E, 0x3E, 0x1C, 0x1C};
+const uint8_t pacmanUpData[] PROGMEM = {0x1C, 0x1C, 0x3E, 0x3E, 0x79, 0x7F, 0x77, 0x7F, 0x79, 0x7F, 0x3E, 0x3E, 0x1C, 0x1C};
+const uint8_t ghostData[] PROGMEM = {0x7C, 0x7C, 0xFE, 0xFE, 0x7B, 0x7F, 0x7F, 0x7F, 0x7B, 0x7F, 0xFE, 0xFE, 0x1C, 0x1C};
+const uint8_t dotData[] PROGMEM = {0x02, 0x02, 0x07, 0x07, 0x02, 0x02};
+const uint8_t birdData[] PROGMEM = {0x02, 0x02, 0x05, 0x07, 0x02, 0x02};
+const uint8_t frogData[] PROGMEM = {0x0F, 0x0F, 0x0D, 0x0F, 0x0F, 0x0F, 0x0D, 0x0F};
+const uint8_t carData[] PROGMEM = {0x3F, 0x3F, 0x3F, 0x3F, 0x3B, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3B, 0x3F, 0x3F, 0x3F};
+
+const Sprite spritePacman[4] = {
+  {0, 7, 7, 3, 3, pacmanRightData},
+  {1, 7, 7, 3, 3, pacmanDownData},
+  {2, 7, 7, 3, 3, pacmanLeftData},
+  {3, 7, 7, 3, 3, pacmanUpData}
+};
+const Sprite spriteGhost = {4, 7, 8, 3, 4, ghostData};
+const Sprite spriteDot = {5, 3, 3, 1, 1, dotData};
+const Sprite spriteBird = {6, 3, 3, 1, 1, birdData};
+const Sprite spriteFrog = {7, 4, 4, 0, 0, frogData};
+const Sprite spriteCar = {8, 8, 6, 0, 0, carData};
+
+const Sprite* const spriteTable[SPRITE_COUNT] = {
+  &spritePacman[0],
+  &spritePacman[1],
+  &spritePacman[2],
+  &spritePacman[3],
+  &spriteGhost,
+  &spriteDot,
+  &spriteBird,
+  &spriteFrog,
+  &spriteCar
+};
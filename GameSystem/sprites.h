@@ -0,0 +1,29 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include "config.h"
+
+// Pre-rendered sprite in SSD1306 page layout. Every column is two bytes,
+// the pixel values and the mask of pixels the sprite touches, bit 0 being
+// the top row. Drawn with display.drawSprite() at its anchor point.
+struct Sprite {
+  uint8_t id;           // Index in spriteTable
+  uint8_t width;
+  uint8_t height;       // At most 8 rows, so a sprite spans two pages at most
+  int8_t originX;       // Anchor position inside the sprite
+  int8_t originY;
+  const uint8_t* data;  // PROGMEM
+};
+
+#define SPRITE_COUNT 9
+
+// Generated by tools/make_sprites.py
+extern const Sprite spritePacman[4]; // Indexed by Pac-Man direction
+extern const Sprite spriteGhost;
+extern const Sprite spriteDot;       // Pac-Man dots and Snake food
+extern const Sprite spriteBird;
+extern const Sprite spriteFrog;
+extern const Sprite spriteCar;
+extern const Sprite* const spriteTable[SPRITE_COUNT];
+
+#endif
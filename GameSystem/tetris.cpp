@@ -1,8 +1,8 @@
 #include "tetris.h"
 #include "display.h"
 #include "input.h"
-
-TetrisGame tetrisGame;
+#include "frameclock.h"
+#include "replay.h"
 
 // Tetris piece shapes (4x4 grid for each rotation)
 const uint8_t tetrisPieces[7][4][4][4] = {
@@ -57,6 +57,7 @@ void TetrisGame::init() {
   dropSpeed = 500;
   lastDropTime = 0;
   gameOver = false;
+  frameVersion = 0;
   
   spawnNewPiece();
 }
@@ -64,7 +65,7 @@ void TetrisGame::init() {
 void TetrisGame::update() {
   handleInput();
   
-  if (millis() - lastDropTime > dropSpeed) {
+  if (frameClock.now() - lastDropTime > dropSpeed) {
     if (!movePiece(0, 1, 0)) {
       placePiece();
       clearLines();
@@ -74,7 +75,8 @@ void TetrisGame::update() {
         gameOver = true;
       }
     }
-    lastDropTime = millis();
+    lastDropTime = frameClock.now();
+    frameVersion++;
   }
 }
 
@@ -117,28 +119,31 @@ void TetrisGame::draw() {
   display.setCursor(scoreX, 5);
   display.println(F("Score:"));
   display.setCursor(scoreX, 15);
-  display.println(score);
+  display.printNumber(score);
+  display.println();
   
   display.setCursor(scoreX, 30);
   display.println(F("Level:"));
   display.setCursor(scoreX, 40);
-  display.println(level);
+  display.printNumber(level);
+  display.println();
   
   display.setCursor(scoreX, 55);
   display.print(F("L:"));
-  display.print(linesCleared);
+  display.printNumber(linesCleared);
   
   updateDisplay();
 }
 
 void TetrisGame::handleInput() {
-  if (buttons.leftPressed) {
+  // Moves repeat while held, rotation needs a press each time
+  if (buttons.leftRepeat) {
     movePiece(-1, 0, 0);
   }
-  else if (buttons.rightPressed) {
+  else if (buttons.rightRepeat) {
     movePiece(1, 0, 0);
   }
-  else if (buttons.downPressed) {
+  else if (buttons.downRepeat) {
     movePiece(0, 1, 0);
   }
   else if (buttons.upPressed) {
@@ -149,7 +154,7 @@ void TetrisGame::handleInput() {
 void TetrisGame::spawnNewPiece() {
   currentPiece.x = TETRIS_WIDTH / 2 - 2;
   currentPiece.y = 0;
-  currentPiece.type = random(0, 7);
+  currentPiece.type = gameRandom(0, 7);
   currentPiece.rotation = 0;
 }
 
@@ -159,6 +164,7 @@ bool TetrisGame::movePiece(int dx, int dy, int dr) {
   int newRotation = (currentPiece.rotation + dr) % 4;
   
   if (isValidPosition(newX, newY, currentPiece.type, newRotation)) {
+    frameVersion++;
     currentPiece.x = newX;
     currentPiece.y = newY;
     currentPiece.rotation = newRotation;
@@ -240,4 +246,18 @@ void TetrisGame::clearLines() {
       dropSpeed = max(50, dropSpeed - 50);
     }
   }
-}
\ No newline at end of file
+}
+
+void TetrisGame::serialize(SaveStream& state) {
+  state.bytes(board, sizeof(board));
+  state.value(currentPiece.x);
+  state.value(currentPiece.y);
+  state.value(currentPiece.type);
+  state.value(currentPiece.rotation);
+  state.time(lastDropTime);
+  state.value(dropSpeed);
+  state.value(score);
+  state.value(level);
+  state.value(linesCleared);
+  state.value(gameOver);
+}
@@ -2,6 +2,7 @@
 #define TETRIS_H
 
 #include "config.h"
+#include "savestate.h"
 
 #define TETRIS_WIDTH 10
 #define TETRIS_HEIGHT 16
@@ -27,6 +28,7 @@ private:
   int level;
   int linesCleared;
   bool gameOver;
+  unsigned long frameVersion;
   
   void spawnNewPiece();
   bool movePiece(int dx, int dy, int dr);
@@ -39,11 +41,12 @@ public:
   void update();
   void draw();
   void handleInput();
+  void serialize(SaveStream& state);
   bool isGameOver() { return gameOver; }
+  bool isGameWon() { return false; }
+  unsigned long getFrameVersion() { return frameVersion; }
   int getScore() { return score; }
   const char* getName() { return "TETRIS"; }
 };
 
-extern TetrisGame tetrisGame;
-
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "text.h"
+#include "display.h"
+
+#define TEXT_FONT_FIRST 0x20
+#define TEXT_FONT_LAST 0x7E
+#define TEXT_DIGITS "0123456789-"
+
+// Metrics of the GFX font measured last. Fonts are const objects in their
+// headers, so each translation unit has its own copy and the cache is keyed
+// by pointer rather than by font.
+static GlyphMetrics fontMetrics[TEXT_FONT_LAST - TEXT_FONT_FIRST + 1];
+static const GFXfont* metricsFont = NULL;
+static uint16_t metricsFirst;
+static uint16_t metricsLast;
+static uint8_t digitGlyphs[sizeof(TEXT_DIGITS) - 1][5];
+static bool digitsReady = false;
+
+static void loadMetrics(const GFXfont* font) {
+  const GFXglyph* glyphs = (const GFXglyph*)pgm_read_ptr(&font->glyph);
+  metricsFirst = pgm_read_word(&font->first);
+  metricsLast = pgm_read_word(&font->last);
+  
+  for (uint16_t c = TEXT_FONT_FIRST; c <= TEXT_FONT_LAST; c++) {
+    GlyphMetrics& m = fontMetrics[c - TEXT_FONT_FIRST];
+    if (c < metricsFirst || c > metricsLast) {
+      m.xOffset = 0;
+      m.width = 0;
+      m.xAdvance = 0;
+      continue;
+    }
+    const GFXglyph* glyph = &glyphs[c - metricsFirst];
+    m.xOffset = (int8_t)pgm_read_byte(&glyph->xOffset);
+    m.width = pgm_read_byte(&glyph->width);
+    m.xAdvance = pgm_read_byte(&glyph->xAdvance);
+  }
+  metricsFont = font;
+}
+
+void initText() {
+  loadMetrics(&Ethnocentric_Rg_It5pt7b);
+  
+#if !DISPLAY_PAGED
+  // Take the digits from the library font so they always match print()
+  display.clearDisplay();
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(0, 0);
+  display.print(F(TEXT_DIGITS));
+  
+  const uint8_t* buffer = display.getBuffer();
+  for (uint8_t i = 0; i < sizeof(digitGlyphs) / sizeof(digitGlyphs[0]); i++) {
+    memcpy(digitGlyphs[i], buffer + i * TEXT_CHAR_WIDTH, sizeof(digitGlyphs[i]));
+  }
+  
+  display.clearDisplay();
+  display.setCursor(0, 0);
+  digitsReady = true;
+#endif
+}
+
+int16_t textWidth(const char* text, uint8_t textSize, const GFXfont* font) {
+  if (!font) {
+    int16_t width = 0;
+    for (const char* c = text; *c; c++) {
+      if (*c == '\n') return -1;
+      if (*c == '\r') continue;
+      width += TEXT_CHAR_WIDTH * textSize;
+      if (width > SCREEN_WIDTH) return -1;
+    }
+    return width;
+  }
+  
+  if (font != metricsFont) loadMetrics(font);
+  
+  // Same bounds as getTextBounds: leftmost to rightmost glyph box
+  int16_t x = 0;
+  int16_t minX = SCREEN_WIDTH;
+  int16_t maxX = -1;
+  for (const char* c = text; *c; c++) {
+    uint8_t ch = *c;
+    if (ch == '\n') return -1;
+    if (ch < TEXT_FONT_FIRST || ch > TEXT_FONT_LAST) {
+      // Glyphs outside the table still count when the font has them
+      if (ch >= metricsFirst && ch <= metricsLast) return -1;
+      continue;
+    }
+    
+    const GlyphMetrics& m = fontMetrics[ch - TEXT_FONT_FIRST];
+    if (x + (m.xOffset + m.width) * textSize > SCREEN_WIDTH) return -1;
+    
+    int16_t x1 = x + m.xOffset * textSize;
+    int16_t x2 = x1 + m.width * textSize - 1;
+    if (x1 < minX) minX = x1;
+    if (x2 > maxX) maxX = x2;
+    x += m.xAdvance * textSize;
+  }
+  return (maxX >= minX) ? maxX - minX + 1 : 0;
+}
+
+const uint8_t* digitGlyph(char c) {
+  if (!digitsReady) return NULL;
+  if (c == '-') return digitGlyphs[10];
+  if (c < '0' || c > '9') return NULL;
+  return digitGlyphs[c - '0'];
+}
+
+int16_t centeredTextX(const char* text, uint8_t textSize) {
+  int16_t w = textWidth(text, textSize, display.getFont());
+  if (w < 0) {
+    // Wrapping text, let GFX measure it
+    int16_t x1, y1;
+    uint16_t h;
+    uint16_t bounds;
+    display.setTextSize(textSize);
+    display.getTextBounds(text, 0, 0, &x1, &y1, &bounds, &h);
+    w = bounds;
+  }
+  return (SCREEN_WIDTH - w) / 2;
+}
+
+void drawCenteredText(CenteredText& text, int y) {
+  if (!text.measured) {
+    text.x = centeredTextX(text.text, text.textSize);
+    text.measured = true;
+  }
+  
+  display.setTextSize(text.textSize);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(text.x, y);
+  display.print(text.text);
+}
@@ -0,0 +1,39 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include "config.h"
+
+// Built-in font cell, 5 glyph columns plus one column of spacing
+#define TEXT_CHAR_WIDTH 6
+#define TEXT_CHAR_HEIGHT 8
+
+// Horizontal metrics of one GFX font glyph
+struct GlyphMetrics {
+  int8_t xOffset;
+  uint8_t width;
+  uint8_t xAdvance;
+};
+
+// Constant text centered on the screen, its position is measured with the
+// current font on the first draw and reused after that
+struct CenteredText {
+  const char* text;
+  uint8_t textSize;
+  int16_t x;
+  bool measured;
+};
+
+void initText();
+
+// Width getTextBounds() would report for text drawn from x = 0, or -1 when
+// the text would wrap or contains line breaks
+int16_t textWidth(const char* text, uint8_t textSize, const GFXfont* font = NULL);
+
+// Columns of a built-in font digit or '-', NULL until initText() ran
+const uint8_t* digitGlyph(char c);
+
+// Cursor x that centers text, falls back to getTextBounds when needed
+int16_t centeredTextX(const char* text, uint8_t textSize);
+void drawCenteredText(CenteredText& text, int y);
+
+#endif
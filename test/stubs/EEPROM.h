@@ -0,0 +1,39 @@
+// EEPROM.h - host stand-in for the ESP32 EEPROM library, kept in RAM
+#ifndef EEPROM_H
+#define EEPROM_H
+
+#include "Arduino.h"
+
+#define HOST_EEPROM_SIZE 4096
+
+class EEPROMClass {
+private:
+  uint8_t data[HOST_EEPROM_SIZE];
+  
+public:
+  EEPROMClass() { memset(data, 0xFF, sizeof(data)); }
+  bool begin(size_t size) { return size <= HOST_EEPROM_SIZE; }
+  bool commit() { return true; }
+  uint8_t read(int address) { return data[address]; }
+  void write(int address, uint8_t value) { data[address] = value; }
+  size_t readBytes(int address, void* value, size_t size) {
+    memcpy(value, data + address, size);
+    return size;
+  }
+  size_t writeBytes(int address, const void* value, size_t size) {
+    memcpy(data + address, value, size);
+    return size;
+  }
+  template <typename T> T& get(int address, T& value) {
+    memcpy(&value, data + address, sizeof(T));
+    return value;
+  }
+  template <typename T> const T& put(int address, const T& value) {
+    memcpy(data + address, &value, sizeof(T));
+    return value;
+  }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,30 @@
+// Wire.h - host stand-in for the I2C bus, with an SSD1306 on the other end
+#ifndef WIRE_H
+#define WIRE_H
+
+#include "Arduino.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+// Transmissions go to an emulated SSD1306 that keeps its own GDDRAM, so a
+// test can check what the panel would show against the framebuffer.
+// Only the commands the sketch sends are understood: horizontal
+// addressing with column and page windows.
+class TwoWire {
+private:
+  uint8_t buffer[I2C_BUFFER_LENGTH];
+  size_t length;
+  
+public:
+  TwoWire() : length(0) {}
+  void begin(int sda = -1, int scl = -1) {}
+  void setClock(uint32_t frequency) {}
+  void beginTransmission(uint8_t address) { length = 0; }
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t size);
+  uint8_t endTransmission(bool sendStop = true);
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,113 @@
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "host.h"
+#include <stdarg.h>
+#include <atomic>
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+bool hostSerialEcho = false;
+
+// Read by the flush thread too
+static std::atomic<unsigned long> virtualMicros(0);
+
+unsigned long millis() {
+  return virtualMicros / 1000;
+}
+
+unsigned long micros() {
+  return virtualMicros;
+}
+
+void delay(unsigned long ms) {
+  virtualMicros += ms * 1000UL;
+}
+
+void hostAdvanceMicros(unsigned long micros) {
+  virtualMicros += micros;
+}
+
+// Pins idle high, as with INPUT_PULLUP and no button pressed
+#define HOST_PINS 40
+static int pinLevels[HOST_PINS];
+static void (*pinHandlers[HOST_PINS])(void*);
+static void* pinHandlerArgs[HOST_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  pinLevels[pin] = HIGH;
+}
+
+int digitalRead(uint8_t pin) {
+  return pinLevels[pin];
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+  pinHandlers[pin] = handler;
+  pinHandlerArgs[pin] = arg;
+}
+
+void hostSetPin(uint8_t pin, int level) {
+  if (pinLevels[pin] == level) return;
+  pinLevels[pin] = level;
+  if (pinHandlers[pin]) pinHandlers[pin](pinHandlerArgs[pin]);
+}
+
+static unsigned long long randomState = 12345;
+
+long random(long high) {
+  if (high <= 0) return 0;
+  randomState = randomState * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (long)((randomState >> 33) % high);
+}
+
+long random(long low, long high) {
+  return low >= high ? low : low + random(high - low);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed) randomState = seed;
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t written = 0;
+  while (size--) written += write(*buffer++);
+  return written;
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char digits[8 * sizeof(long) + 1];
+  char* p = &digits[sizeof(digits) - 1];
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    unsigned long digit = n % base;
+    n /= base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+  } while (n);
+  return write(p);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 10 && n < 0) return print('-') + printNumber(-(unsigned long)n, 10);
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char text[32];
+  snprintf(text, sizeof(text), "%.*f", digits, n);
+  return write(text);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char text[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  return write(text);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (hostSerialEcho) fputc(c, stdout);
+  return 1;
+}
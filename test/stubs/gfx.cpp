@@ -0,0 +1,540 @@
+#include "Adafruit_SSD1306.h"
+
+// Stand-in glyphs for the classic 5x7 font. Tests compare drawing paths
+// with each other, so any fixed pattern will do.
+static uint8_t font[1280];
+
+static struct FontPattern {
+  FontPattern() {
+    for (int i = 0; i < 1280; i++) font[i] = ((i * 73 + 11) ^ (i >> 3)) & 0x7F;
+  }
+} fontPattern;
+
+#define swapInt16(a, b) { int16_t t = a; a = b; b = t; }
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+  _width = w;
+  _height = h;
+  rotation = 0;
+  cursor_x = cursor_y = 0;
+  textsize_x = textsize_y = 1;
+  textcolor = textbgcolor = 0xFFFF;
+  wrap = true;
+  _cp437 = false;
+  gfxFont = NULL;
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    swapInt16(x0, y0);
+    swapInt16(x1, y1);
+  }
+  if (x0 > x1) {
+    swapInt16(x0, x1);
+    swapInt16(y0, y1);
+  }
+  
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (steep) {
+      writePixel(y0, x0, color);
+    } else {
+      writePixel(x0, y0, color);
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  startWrite();
+  writeLine(x, y, x, y + h - 1, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  startWrite();
+  writeLine(x, y, x + w - 1, y, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  for (int16_t i = x; i < x + w; i++) writeFastVLine(i, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (x0 == x1) {
+    if (y0 > y1) swapInt16(y0, y1);
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+  } else if (y0 == y1) {
+    if (x0 > x1) swapInt16(x0, x1);
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+  } else {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  
+  startWrite();
+  writePixel(x0, y0 + r, color);
+  writePixel(x0, y0 - r, color);
+  writePixel(x0 + r, y0, color);
+  writePixel(x0 - r, y0, color);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    writePixel(x0 + x, y0 + y, color);
+    writePixel(x0 - x, y0 + y, color);
+    writePixel(x0 + x, y0 - y, color);
+    writePixel(x0 - x, y0 - y, color);
+    writePixel(x0 + y, y0 + x, color);
+    writePixel(x0 - y, y0 + x, color);
+    writePixel(x0 + y, y0 - x, color);
+    writePixel(x0 - y, y0 - x, color);
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  startWrite();
+  writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHelper(x0, y0, r, 3, 0, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+  
+  delta++;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < (y + 1)) {
+      if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+      if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+    }
+    if (y != py) {
+      if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+      if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7) {
+        b <<= 1;
+      } else {
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      }
+      if (b & 0x80) writePixel(x + i, y, color);
+    }
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7) {
+        b <<= 1;
+      } else {
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      }
+      writePixel(x + i, y, (b & 0x80) ? color : bg);
+    }
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t sizeX, uint8_t sizeY) {
+  if (!gfxFont) {
+    if ((x >= _width) || (y >= _height) || ((x + 6 * sizeX - 1) < 0) || ((y + 8 * sizeY - 1) < 0)) return;
+    if (!_cp437 && (c >= 176)) c++;
+    
+    startWrite();
+    for (int8_t i = 0; i < 5; i++) {
+      uint8_t line = font[c * 5 + i];
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (sizeX == 1 && sizeY == 1) {
+            writePixel(x + i, y + j, color);
+          } else {
+            writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, color);
+          }
+        } else if (bg != color) {
+          if (sizeX == 1 && sizeY == 1) {
+            writePixel(x + i, y + j, bg);
+          } else {
+            writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, bg);
+          }
+        }
+      }
+    }
+    if (bg != color) {
+      if (sizeX == 1 && sizeY == 1) {
+        writeFastVLine(x + 5, y, 8, bg);
+      } else {
+        writeFillRect(x + 5 * sizeX, y, sizeX, 8 * sizeY, bg);
+      }
+    }
+    endWrite();
+    return;
+  }
+  
+  c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+  GFXglyph* glyph = gfxFont->glyph + c;
+  uint8_t* bitmap = gfxFont->bitmap;
+  uint16_t bo = glyph->bitmapOffset;
+  uint8_t w = glyph->width;
+  uint8_t h = glyph->height;
+  int8_t xo = glyph->xOffset;
+  int8_t yo = glyph->yOffset;
+  uint8_t bits = 0;
+  uint8_t bit = 0;
+  int16_t xo16 = 0;
+  int16_t yo16 = 0;
+  if (sizeX > 1 || sizeY > 1) {
+    xo16 = xo;
+    yo16 = yo;
+  }
+  
+  startWrite();
+  for (uint8_t yy = 0; yy < h; yy++) {
+    for (uint8_t xx = 0; xx < w; xx++) {
+      if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+      if (bits & 0x80) {
+        if (sizeX == 1 && sizeY == 1) {
+          writePixel(x + xo + xx, y + yo + yy, color);
+        } else {
+          writeFillRect(x + (xo16 + xx) * sizeX, y + (yo16 + yy) * sizeY, sizeX, sizeY, color);
+        }
+      }
+      bits <<= 1;
+    }
+  }
+  endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (!gfxFont) {
+    if (c == '\n') {
+      cursor_x = 0;
+      cursor_y += textsize_y * 8;
+    } else if (c != '\r') {
+      if (wrap && ((cursor_x + textsize_x * 6) > _width)) {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+      }
+      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+      cursor_x += textsize_x * 6;
+    }
+    return 1;
+  }
+  
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+  } else if (c != '\r') {
+    uint8_t first = pgm_read_byte(&gfxFont->first);
+    if ((c >= first) && (c <= (uint8_t)pgm_read_byte(&gfxFont->last))) {
+      GFXglyph* glyph = gfxFont->glyph + (c - first);
+      uint8_t w = glyph->width;
+      uint8_t h = glyph->height;
+      if ((w > 0) && (h > 0)) {
+        int16_t xo = (int8_t)glyph->xOffset;
+        if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+          cursor_x = 0;
+          cursor_y += (int16_t)textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+      }
+      cursor_x += (uint8_t)glyph->xAdvance * (int16_t)textsize_x;
+    }
+  }
+  return 1;
+}
+
+void Adafruit_GFX::setFont(const GFXfont* f) {
+  // The classic font is drawn from its top, GFX fonts from their baseline
+  if (f) {
+    if (!gfxFont) cursor_y += 6;
+  } else if (gfxFont) {
+    cursor_y -= 6;
+  }
+  gfxFont = (GFXfont*)f;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy) {
+  if (!gfxFont) {
+    if (c == '\n') {
+      *x = 0;
+      *y += textsize_y * 8;
+    } else if (c != '\r') {
+      if (wrap && ((*x + textsize_x * 6) > _width)) {
+        *x = 0;
+        *y += textsize_y * 8;
+      }
+      int x2 = *x + textsize_x * 6 - 1;
+      int y2 = *y + textsize_y * 8 - 1;
+      if (x2 > *maxx) *maxx = x2;
+      if (y2 > *maxy) *maxy = y2;
+      if (*x < *minx) *minx = *x;
+      if (*y < *miny) *miny = *y;
+      *x += textsize_x * 6;
+    }
+    return;
+  }
+  
+  if (c == '\n') {
+    *x = 0;
+    *y += textsize_y * gfxFont->yAdvance;
+  } else if (c != '\r') {
+    if ((c >= gfxFont->first) && (c <= gfxFont->last)) {
+      GFXglyph* glyph = gfxFont->glyph + (c - gfxFont->first);
+      uint8_t gw = glyph->width;
+      uint8_t gh = glyph->height;
+      int8_t xo = glyph->xOffset;
+      int8_t yo = glyph->yOffset;
+      if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+        *x = 0;
+        *y += textsize_y * gfxFont->yAdvance;
+      }
+      int16_t x1 = *x + xo * textsize_x;
+      int16_t y1 = *y + yo * textsize_y;
+      int16_t x2 = x1 + gw * textsize_x - 1;
+      int16_t y2 = y1 + gh * textsize_y - 1;
+      if (x1 < *minx) *minx = x1;
+      if (y1 < *miny) *miny = y1;
+      if (x2 > *maxx) *maxx = x2;
+      if (y2 > *maxy) *maxy = y2;
+      *x += glyph->xAdvance * textsize_x;
+    }
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  
+  uint8_t c;
+  while ((c = *str++)) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t resetPin,
+                                   uint32_t clkDuring, uint32_t clkAfter)
+  : Adafruit_GFX(w, h), wire(twi), buffer(NULL), i2caddr(0), vccstate(0),
+    wireClk(clkDuring), restoreClk(clkAfter) {}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+  free(buffer);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t address, bool reset, bool periphBegin) {
+  if (!buffer && !(buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8)))) return false;
+  clearDisplay();
+  i2caddr = address;
+  vccstate = switchvcc;
+  
+  static const uint8_t init[] = {SSD1306_DISPLAYOFF, SSD1306_MEMORYMODE, 0x00, SSD1306_DISPLAYON};
+  ssd1306_commandList(init, sizeof(init));
+  return true;
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  wire->write(c);
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t* c, uint8_t n) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  uint16_t bytesOut = 1;
+  while (n--) {
+    if (bytesOut >= I2C_BUFFER_LENGTH) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x00);
+      bytesOut = 1;
+    }
+    wire->write(pgm_read_byte(c++));
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::display() {
+  static const uint8_t window[] = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0};
+  ssd1306_commandList(window, sizeof(window));
+  ssd1306_command1(WIDTH - 1);
+  
+  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+  uint8_t* ptr = buffer;
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x40);
+  uint16_t bytesOut = 1;
+  while (count--) {
+    if (bytesOut >= I2C_BUFFER_LENGTH) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x40);
+      bytesOut = 1;
+    }
+    wire->write(*ptr++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+  uint8_t* p = &buffer[x + (y / 8) * WIDTH];
+  uint8_t mask = 1 << (y & 7);
+  switch (color) {
+    case SSD1306_WHITE: *p |= mask; break;
+    case SSD1306_BLACK: *p &= ~mask; break;
+    case SSD1306_INVERSE: *p ^= mask; break;
+  }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if ((y < 0) || (y >= HEIGHT)) return;
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if ((x + w) > WIDTH) w = WIDTH - x;
+  if (w <= 0) return;
+  
+  uint8_t* p = &buffer[(y / 8) * WIDTH + x];
+  uint8_t mask = 1 << (y & 7);
+  switch (color) {
+    case SSD1306_WHITE: while (w--) *p++ |= mask; break;
+    case SSD1306_BLACK: mask = ~mask; while (w--) *p++ &= mask; break;
+    case SSD1306_INVERSE: while (w--) *p++ ^= mask; break;
+  }
+}
+
+static void applyMask(uint8_t* p, uint8_t mask, uint16_t color) {
+  switch (color) {
+    case SSD1306_WHITE: *p |= mask; break;
+    case SSD1306_BLACK: *p &= ~mask; break;
+    case SSD1306_INVERSE: *p ^= mask; break;
+  }
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t top, int16_t height, uint16_t color) {
+  if ((x < 0) || (x >= WIDTH)) return;
+  if (top < 0) {
+    height += top;
+    top = 0;
+  }
+  if ((top + height) > HEIGHT) height = HEIGHT - top;
+  if (height <= 0) return;
+  
+  uint8_t y = top;
+  uint8_t h = height;
+  uint8_t* p = &buffer[(y / 8) * WIDTH + x];
+  
+  // Partial first byte, whole bytes, then a partial last byte
+  uint8_t mod = y & 7;
+  if (mod) {
+    static const uint8_t premask[8] = {0x00, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE};
+    mod = 8 - mod;
+    uint8_t mask = premask[mod];
+    if (h < mod) mask &= (0xFF >> (mod - h));
+    applyMask(p, mask, color);
+    if (h < mod) return;
+    h -= mod;
+    p += WIDTH;
+  }
+  while (h >= 8) {
+    if (color == SSD1306_INVERSE) {
+      *p ^= 0xFF;
+    } else {
+      *p = (color != SSD1306_BLACK) ? 0xFF : 0x00;
+    }
+    p += WIDTH;
+    h -= 8;
+  }
+  if (h) {
+    static const uint8_t postmask[8] = {0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F};
+    applyMask(p, postmask[h], color);
+  }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return false;
+  return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
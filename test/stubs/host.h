@@ -0,0 +1,20 @@
+// host.h - what the host tests control and observe through the stand-ins
+#ifndef HOST_H
+#define HOST_H
+
+#include "Arduino.h"
+
+// Moves the virtual clock behind millis() and micros()
+void hostAdvanceMicros(unsigned long micros);
+
+// Drives a button pin, calling its interrupt handler when the level changes
+void hostSetPin(uint8_t pin, int level);
+
+// GDDRAM of the emulated SSD1306 and the bytes sent to it so far
+const uint8_t* hostPanel();
+unsigned long hostBusBytes();
+
+// Serial output is dropped unless this is set
+extern bool hostSerialEcho;
+
+#endif
@@ -0,0 +1,96 @@
+#include "Wire.h"
+#include "host.h"
+#include <atomic>
+
+TwoWire Wire;
+
+// SSD1306 GDDRAM in horizontal addressing mode, 8 pages of 128 columns
+static uint8_t panelRam[1024];
+static uint8_t columnStart = 0, columnEnd = 127, pageStart = 0, pageEnd = 7;
+static uint8_t column = 0, page = 0;
+static std::atomic<unsigned long> busBytes(0);
+
+// A command waiting for its arguments
+static uint8_t pendingCommand;
+static uint8_t argumentsLeft = 0;
+static uint8_t arguments[6];
+static uint8_t argumentCount;
+
+static uint8_t argumentsOf(uint8_t command) {
+  switch (command) {
+    case 0x21: case 0x22:                       // Column and page window
+      return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: // Memory mode, contrast, charge pump, multiplex
+    case 0xD3: case 0xD5: case 0xD9: case 0xDA: // Offset, clock, precharge, pins
+    case 0xDB:                                  // VCOM level
+      return 1;
+    case 0x26: case 0x27:                       // Scroll setup
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+static void panelCommand(uint8_t c) {
+  if (argumentsLeft > 0) {
+    arguments[argumentCount++] = c;
+    if (--argumentsLeft > 0) return;
+    if (pendingCommand == 0x21) {
+      columnStart = column = arguments[0] & 127;
+      columnEnd = arguments[1] & 127;
+    } else if (pendingCommand == 0x22) {
+      pageStart = page = arguments[0] & 7;
+      pageEnd = arguments[1] & 7;
+      column = columnStart;
+    }
+    return;
+  }
+  
+  pendingCommand = c;
+  argumentCount = 0;
+  argumentsLeft = argumentsOf(c);
+}
+
+static void panelData(uint8_t d) {
+  panelRam[page * 128 + column] = d;
+  if (++column > columnEnd) {
+    column = columnStart;
+    if (++page > pageEnd) page = pageStart;
+  }
+}
+
+size_t TwoWire::write(uint8_t data) {
+  // The ESP32 Wire library drops what does not fit its buffer
+  if (length >= I2C_BUFFER_LENGTH) return 0;
+  buffer[length++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+  size_t written = 0;
+  while (size--) written += write(*data++);
+  return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  // The control byte says whether the rest is data or commands
+  busBytes += length;
+  bool isData = length > 0 && buffer[0] == 0x40;
+  for (size_t i = 1; i < length; i++) {
+    if (isData) {
+      panelData(buffer[i]);
+    } else {
+      panelCommand(buffer[i]);
+    }
+  }
+  length = 0;
+  return 0;
+}
+
+const uint8_t* hostPanel() {
+  return panelRam;
+}
+
+unsigned long hostBusBytes() {
+  return busBytes;
+}
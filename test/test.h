@@ -0,0 +1,37 @@
+// test.h - checks shared by the host tests, one binary per test file
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+static int checksRun = 0;
+static int checksFailed = 0;
+
+static inline bool checkThat(bool passed, const char* what, const char* file, int line) {
+  checksRun++;
+  if (!passed) {
+    checksFailed++;
+    printf("%s:%d: failed: %s\n", file, line, what);
+  }
+  return passed;
+}
+
+static inline bool checkEqual(long expected, long actual, const char* what, const char* file, int line) {
+  checksRun++;
+  if (expected != actual) {
+    checksFailed++;
+    printf("%s:%d: %s is %ld, expected %ld\n", file, line, what, actual, expected);
+  }
+  return expected == actual;
+}
+
+#define CHECK(condition) checkThat((condition), #condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(expected, actual) checkEqual((long)(expected), (long)(actual), #actual, __FILE__, __LINE__)
+
+// Prints the totals and gives main() its exit code
+static inline int testResult(const char* name) {
+  printf("%s: %d checks, %d failed\n", name, checksRun, checksFailed);
+  return checksFailed ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,214 @@
+// Debounce and repeat of updateInput(), driven by edges queued with
+// injectInputEvent() the way the button interrupts would queue them
+#include "test.h"
+#include "host.h"
+#include "input.h"
+
+#define DEBOUNCE_US (BUTTON_DEBOUNCE * 1000UL)
+#define FRAME_US 16000UL
+
+// Runs updateInput() once the virtual clock reaches `time`
+static void updateAt(unsigned long time) {
+  hostAdvanceMicros(time - micros());
+  updateInput();
+}
+
+static void inject(uint8_t button, bool pressed, unsigned long time) {
+  CHECK(injectInputEvent(button, pressed, time));
+}
+
+// Starts from released buttons with every debounce window over
+static unsigned long startInput() {
+  initInput();
+  hostAdvanceMicros(DEBOUNCE_US);
+  updateInput();
+  return micros() + 1000;
+}
+
+static void testBouncyPress() {
+  unsigned long t = startInput();
+  inject(BUTTON_UP, true, t);
+  inject(BUTTON_UP, false, t + 300);
+  inject(BUTTON_UP, true, t + 700);
+  inject(BUTTON_UP, false, t + 1200);
+  inject(BUTTON_UP, true, t + 1500);
+  
+  // Taken at the first edge, the rest is bounce
+  updateAt(t + 2000);
+  CHECK(wasButtonPressed(BUTTON_UP));
+  CHECK(isButtonDown(BUTTON_UP));
+  CHECK_EQUAL(t, lastButtonTime);
+  
+  updateAt(t + 2000 + FRAME_US);
+  CHECK(!wasButtonPressed(BUTTON_UP));
+  CHECK(!wasButtonReleased(BUTTON_UP));
+  CHECK(isButtonDown(BUTTON_UP));
+  
+  inject(BUTTON_UP, false, micros());
+  updateAt(micros() + FRAME_US);
+  CHECK(wasButtonReleased(BUTTON_UP));
+}
+
+static void testBouncyRelease() {
+  unsigned long t = startInput();
+  inject(BUTTON_DOWN, true, t);
+  updateAt(t + FRAME_US);
+  CHECK(wasButtonPressed(BUTTON_DOWN));
+  
+  unsigned long r = micros();
+  inject(BUTTON_DOWN, false, r);
+  inject(BUTTON_DOWN, true, r + 400);
+  inject(BUTTON_DOWN, false, r + 900);
+  updateAt(r + 2000);
+  CHECK(wasButtonReleased(BUTTON_DOWN));
+  CHECK(!isButtonDown(BUTTON_DOWN));
+  
+  updateAt(r + 2000 + FRAME_US);
+  CHECK(!wasButtonPressed(BUTTON_DOWN));
+  CHECK(!isButtonDown(BUTTON_DOWN));
+}
+
+static void testBounceEndsAtOtherLevel() {
+  unsigned long t = startInput();
+  inject(BUTTON_LEFT, true, t);
+  inject(BUTTON_LEFT, false, t + 1000);
+  
+  // Still inside the window, the press stands
+  updateAt(t + 2000);
+  CHECK(wasButtonPressed(BUTTON_LEFT));
+  CHECK(isButtonDown(BUTTON_LEFT));
+  
+  // The window ended with the button up, that is the release
+  updateAt(t + DEBOUNCE_US + 3000);
+  CHECK(wasButtonReleased(BUTTON_LEFT));
+  CHECK(!wasButtonPressed(BUTTON_LEFT));
+  CHECK(!isButtonDown(BUTTON_LEFT));
+}
+
+static void testPressAfterSettledRelease() {
+  unsigned long t = startInput();
+  inject(BUTTON_RIGHT, true, t);
+  inject(BUTTON_RIGHT, false, t + 1000);
+  updateAt(t + 2000);
+  CHECK(wasButtonPressed(BUTTON_RIGHT));
+  
+  // The bounce settles to a release at t + DEBOUNCE_US when the next edge
+  // is consumed, which is then a press of its own at its own time
+  unsigned long press = t + DEBOUNCE_US + 7000;
+  inject(BUTTON_RIGHT, true, press);
+  updateAt(press + 1000);
+  CHECK(wasButtonReleased(BUTTON_RIGHT));
+  CHECK(wasButtonPressed(BUTTON_RIGHT));
+  CHECK(isButtonDown(BUTTON_RIGHT));
+  CHECK_EQUAL(press, lastButtonTime);
+  
+  inject(BUTTON_RIGHT, false, micros());
+  updateAt(micros() + FRAME_US);
+  CHECK(!isButtonDown(BUTTON_RIGHT));
+}
+
+static void testRepeat() {
+  unsigned long t = startInput();
+  inject(BUTTON_UP, true, t);
+  updateAt(t + 1000);
+  CHECK(isButtonRepeat(BUTTON_UP));
+  
+  // Held: the first repeat after BUTTON_DELAY, then every BUTTON_REPEAT_RATE
+  int repeats = 0;
+  unsigned long firstRepeat = 0;
+  for (unsigned long ms = 10; ms <= 400; ms += 10) {
+    updateAt(t + ms * 1000);
+    if (isButtonRepeat(BUTTON_UP)) {
+      if (repeats++ == 0) firstRepeat = ms;
+    }
+  }
+  CHECK_EQUAL(BUTTON_DELAY, firstRepeat);
+  CHECK_EQUAL((400 - BUTTON_DELAY) / BUTTON_REPEAT_RATE + 1, repeats);
+  
+  inject(BUTTON_UP, false, micros());
+  updateAt(micros() + 1000);
+  for (int i = 0; i < 20; i++) {
+    updateAt(micros() + FRAME_US);
+    CHECK(!isButtonRepeat(BUTTON_UP));
+  }
+}
+
+static void testPinLookup() {
+  static const int pins[BUTTON_COUNT] = {PIN_BUTTON_UP, PIN_BUTTON_DOWN, PIN_BUTTON_LEFT, PIN_BUTTON_RIGHT};
+  unsigned long t = startInput();
+  inject(BUTTON_LEFT, true, t);
+  updateAt(t + 1000);
+  
+  // The pin functions read the same masks as the Button ones
+  for (uint8_t b = 0; b < BUTTON_COUNT; b++) {
+    CHECK_EQUAL(b == BUTTON_LEFT, isButtonPressed(pins[b]));
+    CHECK_EQUAL(b == BUTTON_LEFT, wasButtonJustPressed(pins[b]));
+  }
+  CHECK(!isButtonPressed(PIN_SDA));
+  
+  updateAt(t + 1000 + FRAME_US);
+  CHECK(isButtonPressed(PIN_BUTTON_LEFT));
+  CHECK(!wasButtonJustPressed(PIN_BUTTON_LEFT));
+  inject(BUTTON_LEFT, false, micros());
+  updateAt(micros() + FRAME_US);
+  CHECK(!isButtonPressed(PIN_BUTTON_LEFT));
+}
+
+struct Edge {
+  unsigned long time;
+  uint8_t button;
+  bool pressed;
+};
+
+#define TAP_BURSTS 50
+#define BURST_EDGES (BUTTON_COUNT * 4)
+
+static void testTapBursts() {
+  unsigned long t = startInput();
+  inputQueue.resetStats();
+  int presses[BUTTON_COUNT] = {0};
+  
+  // Every button tapped twice inside two frames, the taps staggered so
+  // the edges of all four interleave in the queue
+  for (int burst = 0; burst < TAP_BURSTS; burst++) {
+    Edge edges[BURST_EDGES];
+    int count = 0;
+    for (unsigned long offset = 0; offset < 4 * 6000; offset += 6000) {
+      for (uint8_t b = 0; b < BUTTON_COUNT; b++) {
+        edges[count++] = {t + offset + b * 500, b, offset % 12000 == 0};
+      }
+    }
+    
+    // Queued as the interrupts would, when the edges happen
+    int next = 0;
+    for (int frame = 1; frame <= 3; frame++) {
+      unsigned long now = t + frame * FRAME_US;
+      while (next < count && edges[next].time <= now) {
+        inject(edges[next].button, edges[next].pressed, edges[next].time);
+        next++;
+      }
+      updateAt(now);
+      for (uint8_t b = 0; b < BUTTON_COUNT; b++) {
+        if (wasButtonPressed((Button)b)) presses[b]++;
+      }
+    }
+    t += 3 * FRAME_US;
+  }
+  
+  CHECK_EQUAL(0, inputQueue.getDropped());
+  CHECK_EQUAL(TAP_BURSTS * BURST_EDGES, inputQueue.getPushed());
+  for (uint8_t b = 0; b < BUTTON_COUNT; b++) {
+    CHECK_EQUAL(TAP_BURSTS * 2, presses[b]);
+  }
+}
+
+int main() {
+  testBouncyPress();
+  testBouncyRelease();
+  testBounceEndsAtOtherLevel();
+  testPressAfterSettledRelease();
+  testRepeat();
+  testPinLookup();
+  testTapBursts();
+  return testResult("input");
+}
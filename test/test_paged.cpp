@@ -0,0 +1,61 @@
+// Every registered game played through GameManager with the paged display,
+// whose list is too small for most frames. Each page sent to the panel,
+// recorded or drawn in a page pass, has to match the framebuffer.
+#include "test.h"
+#include "host.h"
+#include "display.h"
+#include "gamemanager.h"
+#include "gameregistry.h"
+#include "frameclock.h"
+#include "input.h"
+#include "replay.h"
+
+#define FRAME_US (GAME_TICK_MS * 1000UL)
+#define PLAY_FRAMES 600
+
+// Plays one game from the menu until it ends or PLAY_FRAMES have passed,
+// tapping the buttons in turn so it moves
+static void playGame(const GameEntry& game) {
+  seedGameRandom(game.id + 1);
+  gameManager.setGame(game.id);
+  CHECK(gameManager.getState() == STATE_PLAYING);
+  
+  for (int i = 0; i < PLAY_FRAMES && gameManager.getState() == STATE_PLAYING; i++) {
+    uint8_t button = (i / 8) % BUTTON_COUNT;
+    if (i % 8 == 0) injectInputEvent(button, true, micros());
+    if (i % 8 == 4) injectInputEvent(button, false, micros());
+    
+    hostAdvanceMicros(FRAME_US);
+    frameClock.advance(GAME_TICK_MS);
+    updateInput();
+    gameManager.update();
+    gameManager.render();
+  }
+  
+  // Back to the menu, which is drawn and checked as well
+  gameManager.setState(STATE_MENU);
+}
+
+int main() {
+  initDisplay();
+  initInput();
+  initGameManager();
+  
+  for (int i = 0; i < GameRegistry::count; i++) {
+    const GameEntry& game = GameRegistry::games[i];
+    unsigned long mismatches = display.getVerifyMismatches();
+    playGame(game);
+    if (!CHECK_EQUAL(mismatches, display.getVerifyMismatches())) {
+      printf("  game %s\n", game.name);
+    }
+  }
+  
+  // The list has to overflow for the page passes to be tested at all;
+  // HEADLESS builds draw no frames
+#if !HEADLESS
+  CHECK(display.getListOverflows() > 0);
+  CHECK(display.getPagePasses() > 0);
+#endif
+  CHECK_EQUAL(0, display.getVerifyMismatches());
+  return testResult("paged");
+}
@@ -0,0 +1,122 @@
+// The bodies of Flappy Bird, Breakout and Helicopter follow the same path
+// at every GAME_TICK_MS, given the same input
+#include "test.h"
+#include "gamearena.h"
+#include "flappy.h"
+#include "breakout.h"
+#include "helicopter.h"
+#include "frameclock.h"
+#include "input.h"
+#include "replay.h"
+
+#define START_TIME 1024
+#define RUN_MS 8000
+#define SAMPLE_MS 32  // Every tick rate below has an update at these times
+#define SAMPLES (RUN_MS / SAMPLE_MS)
+#define MIN_PLAY_MS 1000  // Shortest game the scripts may play
+
+static const unsigned long tickRates[] = {8, 16, 32};
+
+struct Sample {
+  int32_t x, y;
+  bool gameOver;
+};
+
+// Buttons a game is played with, held from game time t for SAMPLE_MS. They
+// are picked at the start of each interval, where every tick rate has just
+// updated, so all rates play the same input for as long as their paths agree.
+typedef uint8_t (*Script)(void* game, unsigned long t);
+
+static uint8_t flapBelowMiddle(void* game, unsigned long t) {
+  const Body& bird = static_cast<FlappyGame*>(game)->getBird();
+  return (bird.y > SCREEN_HEIGHT / 2 && bird.velY >= 0) ? BUTTON_BIT(BUTTON_UP) : 0;
+}
+
+static uint8_t sweepPaddle(void* game, unsigned long t) {
+  if ((t / 128) % 5 == 1 || (t / 128) % 5 == 2) return BUTTON_BIT(BUTTON_RIGHT);
+  return ((t / 192) % 2 == 1) ? BUTTON_BIT(BUTTON_LEFT) : 0;
+}
+
+static uint8_t liftBelowMiddle(void* game, unsigned long t) {
+  const Body& heli = static_cast<HelicopterGame*>(game)->getHeli();
+  return (heli.y > SCREEN_HEIGHT / 2 - 6) ? BUTTON_BIT(BUTTON_UP) : 0;
+}
+
+static void setButtons(uint8_t held, uint8_t pressed) {
+  buttons = {};
+  buttons.up = held & BUTTON_BIT(BUTTON_UP);
+  buttons.left = held & BUTTON_BIT(BUTTON_LEFT);
+  buttons.right = held & BUTTON_BIT(BUTTON_RIGHT);
+  buttons.upPressed = pressed & BUTTON_BIT(BUTTON_UP);
+  buttons.leftPressed = pressed & BUTTON_BIT(BUTTON_LEFT);
+  buttons.rightPressed = pressed & BUTTON_BIT(BUTTON_RIGHT);
+}
+
+static const Body& flappyBody(void* game) { return static_cast<FlappyGame*>(game)->getBird(); }
+static const Body& breakoutBody(void* game) { return static_cast<BreakoutGame*>(game)->getBall(); }
+static const Body& helicopterBody(void* game) { return static_cast<HelicopterGame*>(game)->getHeli(); }
+
+// Plays the game at one tick rate, sampling its body every SAMPLE_MS
+static void play(const GameEntry& game, const Body& (*body)(void*), Script script,
+                 unsigned long tick, Sample* samples) {
+  void* data = gameArena.getData();
+  seedGameRandom(1);
+  frameClock.set(START_TIME);
+  gameArena.start(game);
+  game.init(data);
+  
+  uint8_t held = 0;
+  for (unsigned long t = 0; t < RUN_MS; t += tick) {
+    uint8_t last = held;
+    if (t % SAMPLE_MS == 0) held = script(data, t);
+    setButtons(held, held & ~last);
+    frameClock.advance(tick);
+    game.update(data);
+    
+    unsigned long now = t + tick;
+    if (now % SAMPLE_MS == 0) {
+      const Body& b = body(data);
+      samples[now / SAMPLE_MS - 1] = {b.x.getRaw(), b.y.getRaw(), game.isGameOver(data)};
+    }
+  }
+}
+
+static void testGame(GameID id, const Body& (*body)(void*), Script script) {
+  int index = GameRegistry::indexOf(id);
+  if (index < 0) return; // Left out of this build
+  const GameEntry& game = GameRegistry::games[index];
+  
+  static Sample reference[SAMPLES];
+  static Sample samples[SAMPLES];
+  play(game, body, script, tickRates[0], reference);
+  
+  // The script has to keep the game going for a while to compare anything
+  int alive = 0;
+  while (alive < SAMPLES && !reference[alive].gameOver) alive++;
+  CHECK(alive * SAMPLE_MS >= MIN_PLAY_MS);
+  CHECK(reference[0].x != reference[alive - 1].x || reference[0].y != reference[alive - 1].y);
+  
+  for (unsigned i = 1; i < sizeof(tickRates) / sizeof(tickRates[0]); i++) {
+    play(game, body, script, tickRates[i], samples);
+    int differing = 0;
+    for (int s = 0; s < SAMPLES; s++) {
+      const Sample& a = reference[s];
+      const Sample& b = samples[s];
+      if (a.x == b.x && a.y == b.y && a.gameOver == b.gameOver) continue;
+      if (differing++ == 0) {
+        printf("  %s at %lu ms: %.3f,%.3f at %lu ms ticks, %.3f,%.3f at %lu ms ticks\n", game.name,
+               (unsigned long)(s + 1) * SAMPLE_MS, Fixed::fromRaw(a.x).toFloat(), Fixed::fromRaw(a.y).toFloat(),
+               tickRates[0], Fixed::fromRaw(b.x).toFloat(), Fixed::fromRaw(b.y).toFloat(), tickRates[i]);
+      }
+    }
+    CHECK_EQUAL(0, differing);
+  }
+}
+
+int main() {
+  testGame(GAME_FLAPPY, flappyBody, flapBelowMiddle);
+  testGame(GAME_BREAKOUT, breakoutBody, sweepPaddle);
+  testGame(GAME_HELICOPTER, helicopterBody, liftBelowMiddle);
+  gameArena.stop();
+  return testResult("physics");
+}
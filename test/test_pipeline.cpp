@@ -0,0 +1,105 @@
+// The flush thread sends what the game loop renders, over the stand-in bus.
+// Builds without the thread only check that the loop flushes, and HEADLESS
+// builds flush nothing at all.
+#include "test.h"
+#include "host.h"
+#include "display.h"
+#include "framepipeline.h"
+#include "latency.h"
+#include <thread>
+
+#define PIPELINE_FRAMES 200
+
+#if !DISPLAY_PAGED && !HEADLESS
+static bool panelShowsBuffer() {
+  return memcmp(hostPanel(), display.getBuffer(), DISPLAY_BUFFER_SIZE) == 0;
+}
+
+static void drawFrame(int i) {
+  display.clearDisplay();
+  display.fillRect(i % SCREEN_WIDTH, (i * 7) % SCREEN_HEIGHT, 9, 5, SSD1306_WHITE);
+  display.drawCircle((i * 3) % SCREEN_WIDTH, 32, 6 + i % 10, SSD1306_WHITE);
+}
+
+#if FRAME_PIPELINE_ENABLED
+static void testFlushThread() {
+  CHECK(framePipeline.isRunning());
+  
+  // The game loop does not wait, frames it outruns the thread with are skipped
+  for (int i = 0; i < PIPELINE_FRAMES; i++) {
+    drawFrame(i);
+    updateDisplay();
+    if (i % 10 == 0) std::this_thread::sleep_for(std::chrono::microseconds(300));
+  }
+  CHECK_EQUAL(PIPELINE_FRAMES, framePipeline.getFramesProduced());
+  
+  // end() flushes the newest frame before the thread stops
+  framePipeline.end();
+  CHECK(!framePipeline.isRunning());
+  CHECK(framePipeline.getFramesFlushed() >= 1);
+  CHECK(framePipeline.getFramesFlushed() <= framePipeline.getFramesProduced());
+  CHECK(panelShowsBuffer());
+}
+#endif
+
+static void testFlushOnLoop() {
+  // Without the thread updateDisplay() flushes right away
+  for (int i = 0; i < 20; i++) {
+    drawFrame(i * 13);
+    updateDisplay();
+    CHECK(panelShowsBuffer());
+  }
+}
+
+#if FRAME_PIPELINE_ENABLED
+static void testRestart() {
+  // begin() again stops the old thread and starts a new one
+  initDisplay();
+  framePipeline.begin();
+  CHECK(framePipeline.isRunning());
+  drawFrame(5);
+  updateDisplay();
+  framePipeline.end();
+  CHECK_EQUAL(1, framePipeline.getFramesProduced());
+  CHECK_EQUAL(1, framePipeline.getFramesFlushed());
+  CHECK(panelShowsBuffer());
+}
+
+#if TRACK_INPUT_LATENCY
+static void testLatencyFromThread() {
+  // The thread queues the press to flush time, the loop adds it up
+  initDisplay();
+  latencyTracker.setGame(0);
+  latencyTracker.resetStats(0);
+  hostAdvanceMicros(1000);
+  latencyTracker.pressCaptured(micros());
+  hostAdvanceMicros(4000);
+  drawFrame(9);
+  updateDisplay();
+  framePipeline.end();
+  
+  LatencyStats stats = latencyTracker.getStats(0);
+  CHECK_EQUAL(1, stats.count);
+  CHECK_EQUAL(4000, stats.max);
+  latencyTracker.setGame(-1);
+}
+#endif
+#endif
+#endif
+
+int main() {
+  initDisplay();
+#if !DISPLAY_PAGED && !HEADLESS
+#if FRAME_PIPELINE_ENABLED
+  testFlushThread();
+#endif
+  testFlushOnLoop();
+#if FRAME_PIPELINE_ENABLED
+  testRestart();
+#if TRACK_INPUT_LATENCY
+  testLatencyFromThread();
+#endif
+#endif
+#endif
+  return testResult("pipeline");
+}
@@ -0,0 +1,154 @@
+// Every registered game saves, loads into a fresh instance and saves again
+// to the same bytes, at a few points of a scripted game. The restored game
+// then has to play on exactly like the one it was saved from.
+#include "test.h"
+#include "host.h"
+#include "display.h"
+#include "gamearena.h"
+#include "savestate.h"
+#include "frameclock.h"
+#include "input.h"
+#include "replay.h"
+
+#define FRAME_US (GAME_TICK_MS * 1000UL)
+#define PAYLOAD_SIZE (SAVE_STATE_SIZE - SAVE_STATE_HEADER - 2)
+#define FOLLOW_FRAMES 120
+#define FOLLOW_SEED 12345
+
+// What a game shows and reports after one frame
+struct Frame {
+  int score;
+  bool gameOver;
+  uint32_t pixels;  // Checksum of the framebuffer
+};
+
+static uint16_t save(const GameEntry& game, uint8_t* blob) {
+  SaveStream stream(blob, PAYLOAD_SIZE, false);
+  game.serialize(gameArena.getData(), stream);
+  CHECK(stream.ok());
+  return stream.getLength();
+}
+
+static void load(const GameEntry& game, uint8_t* blob, uint16_t length) {
+  gameArena.start(game);
+  game.init(gameArena.getData());
+  SaveStream stream(blob, length, true);
+  game.serialize(gameArena.getData(), stream);
+  CHECK(stream.ok());
+  CHECK_EQUAL(length, stream.getLength());
+}
+
+static uint32_t frameChecksum() {
+#if DISPLAY_PAGED
+  // No framebuffer to read, the pages are rasterized onto the panel instead
+  display.displayChanges();
+  const uint8_t* buffer = hostPanel();
+#else
+  const uint8_t* buffer = display.getBuffer();
+#endif
+  uint32_t checksum = 2166136261UL;
+  for (int i = 0; i < DISPLAY_BUFFER_SIZE; i++) {
+    checksum = (checksum ^ buffer[i]) * 16777619UL;
+  }
+  return checksum;
+}
+
+// Plays on from the current state with the same buttons, clock steps and
+// random numbers every time, drawing each frame
+static void follow(const GameEntry& game, Frame* frames) {
+  void* data = gameArena.getData();
+  seedGameRandom(FOLLOW_SEED);
+  
+  for (int i = 0; i < FOLLOW_FRAMES; i++) {
+    uint8_t button = (i / 6) % BUTTON_COUNT;
+    bool pressed = i % 6 == 0;
+    buttons = {};
+    buttons.up = button == BUTTON_UP;
+    buttons.down = button == BUTTON_DOWN;
+    buttons.left = button == BUTTON_LEFT;
+    buttons.right = button == BUTTON_RIGHT;
+    buttons.upPressed = buttons.upRepeat = pressed && buttons.up;
+    buttons.downPressed = buttons.downRepeat = pressed && buttons.down;
+    buttons.leftPressed = buttons.leftRepeat = pressed && buttons.left;
+    buttons.rightPressed = buttons.rightRepeat = pressed && buttons.right;
+    
+    frameClock.advance(GAME_TICK_MS);
+    if (!game.isGameOver(data)) game.update(data);
+    game.draw(data);
+    frames[i] = {game.getScore(data), game.isGameOver(data), frameChecksum()};
+  }
+}
+
+static void checkRoundTrip(const GameEntry& game) {
+  // The game saved here plays on first, then its restored copy from the
+  // same clock. Whatever serialize() leaves out shows up as a difference.
+  static Frame original[FOLLOW_FRAMES];
+  static Frame restored[FOLLOW_FRAMES];
+  unsigned long saved = frameClock.now();
+  CHECK(saveState.suspend());
+  follow(game, original);
+  
+  frameClock.set(saved);
+  CHECK(saveState.resume());
+  CHECK(gameArena.getGame() == &game);
+  follow(game, restored);
+  
+  int differing = 0;
+  for (int i = 0; i < FOLLOW_FRAMES; i++) {
+    const Frame& a = original[i];
+    const Frame& b = restored[i];
+    if (a.score == b.score && a.gameOver == b.gameOver && a.pixels == b.pixels) continue;
+    if (differing++ == 0) {
+      printf("  %s frame %d: score %d/%d, over %d/%d, pixels %s\n", game.name, i,
+             a.score, b.score, a.gameOver, b.gameOver, a.pixels == b.pixels ? "same" : "differ");
+    }
+  }
+  CHECK_EQUAL(0, differing);
+  
+  // Saving what was loaded gives the same bytes again
+  uint8_t first[PAYLOAD_SIZE];
+  uint8_t second[PAYLOAD_SIZE];
+  uint16_t length = save(game, first);
+  load(game, first, length);
+  CHECK_EQUAL(length, save(game, second));
+  if (!CHECK(memcmp(first, second, length) == 0)) {
+    printf("  game %s\n", game.name);
+  }
+}
+
+// Plays a few frames with the buttons cycling, so the games move
+static void playFrames(const GameEntry& game, int frames) {
+  for (int i = 0; i < frames; i++) {
+    uint8_t button = (i / 8) % BUTTON_COUNT;
+    if (i % 8 == 0) injectInputEvent(button, true, micros());
+    if (i % 8 == 4) injectInputEvent(button, false, micros());
+    
+    hostAdvanceMicros(FRAME_US);
+    frameClock.advance(GAME_TICK_MS);
+    updateInput();
+    if (!game.isGameOver(gameArena.getData())) game.update(gameArena.getData());
+  }
+}
+
+static void testGame(const GameEntry& game) {
+  seedGameRandom(game.id + 1);
+  gameArena.start(game);
+  game.init(gameArena.getData());
+  checkRoundTrip(game);
+  
+  for (int round = 0; round < 4; round++) {
+    playFrames(game, 60 + round * 90);
+    checkRoundTrip(game);
+  }
+  saveState.discard();
+}
+
+int main() {
+  initDisplay();
+  initInput();
+  for (int i = 0; i < GameRegistry::count; i++) {
+    testGame(GameRegistry::games[i]);
+  }
+  gameArena.stop();
+  return testResult("savestate");
+}
@@ -0,0 +1,108 @@
+// Source art for tools/make_assets.py, as exported by image2cpp
+// (horizontal, 1 bit per pixel). Not compiled into the sketch.
+
+// 'Intro', 128x64px
+const unsigned char epd_bitmap_Intro [] PROGMEM = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0xf8, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0x7f, 
+	0xff, 0xf0, 0x07, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xdf, 0x3f, 
+	0xff, 0xf7, 0xf3, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xfc, 0x07, 0xd1, 0x9f, 
+	0xff, 0xff, 0xf9, 0xff, 0xff, 0xff, 0xff, 0x80, 0x7f, 0xff, 0xef, 0xff, 0xf3, 0xf3, 0xd0, 0xdf, 
+	0xff, 0xfc, 0x0c, 0x1f, 0xff, 0xff, 0xfe, 0x80, 0x3f, 0xff, 0xff, 0xff, 0xcf, 0xf9, 0xd3, 0x6f, 
+	0xff, 0xfd, 0xe6, 0x07, 0xff, 0xff, 0xfd, 0xff, 0x9f, 0xff, 0xff, 0x00, 0x1c, 0x1c, 0xd0, 0xaf, 
+	0xff, 0xfd, 0xf3, 0xf0, 0x00, 0x00, 0x03, 0xff, 0xc8, 0x3f, 0xfe, 0x00, 0x38, 0x0e, 0x5c, 0x2f, 
+	0xff, 0xfd, 0xfb, 0xff, 0xff, 0xff, 0xff, 0x00, 0x60, 0x00, 0x40, 0xff, 0xf3, 0xe7, 0x06, 0x2f, 
+	0xff, 0xfd, 0xf9, 0x02, 0x00, 0x7f, 0xfe, 0x7e, 0x3f, 0xff, 0xbf, 0xc0, 0xe7, 0xf3, 0xb2, 0x2f, 
+	0xff, 0xfd, 0xfc, 0x7d, 0xef, 0x60, 0x00, 0xff, 0xb0, 0x3f, 0xff, 0x80, 0x4f, 0xf9, 0xdb, 0xef, 
+	0xff, 0xfd, 0xfc, 0x7d, 0xef, 0x2f, 0x79, 0xff, 0xc0, 0x00, 0xe0, 0x7f, 0x4f, 0xfc, 0xe8, 0x0f, 
+	0xff, 0xfd, 0xfe, 0xfd, 0xef, 0x8f, 0x7b, 0xff, 0xcf, 0xce, 0x4e, 0x7f, 0x1f, 0xfe, 0x7f, 0xff, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0x8f, 0x7b, 0xff, 0xcf, 0xcf, 0x1e, 0xff, 0x1f, 0x3e, 0x7f, 0xff, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xff, 0xcf, 0xcf, 0x1e, 0xff, 0x3f, 0x1f, 0x3f, 0xff, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xe7, 0x8f, 0xcf, 0xbe, 0xf0, 0x3f, 0x0e, 0x3f, 0xff, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xcf, 0x7b, 0xc3, 0x9f, 0xcf, 0xfe, 0xf0, 0x3f, 0x0c, 0x3f, 0xff, 
+	0x80, 0x0d, 0xff, 0xfd, 0xef, 0xef, 0x7b, 0xc0, 0x1f, 0xcf, 0xfe, 0xfe, 0x1f, 0xc0, 0x38, 0x03, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9f, 0xcf, 0xfe, 0xfe, 0x1f, 0xe0, 0x3f, 0xff, 
+	0x80, 0x0d, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xef, 0xfe, 0xfe, 0x07, 0xf0, 0x70, 0x01, 
+	0xff, 0xfd, 0xff, 0xfd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xef, 0xfe, 0xfe, 0x03, 0xf8, 0xff, 0xff, 
+	0xff, 0xfd, 0xff, 0xbd, 0xef, 0xff, 0x7b, 0xcf, 0x9d, 0xee, 0xee, 0xfe, 0x01, 0xfc, 0xff, 0xff, 
+	0xff, 0xfd, 0xf3, 0xbd, 0xef, 0xff, 0x7b, 0xc3, 0x9f, 0xee, 0xee, 0xf0, 0x00, 0xfe, 0x7f, 0xff, 
+	0xff, 0xfd, 0xf1, 0x3d, 0xef, 0x7f, 0x7b, 0xe3, 0x9f, 0xee, 0xce, 0xf0, 0x18, 0x7e, 0x3f, 0xff, 
+	0xff, 0xfd, 0xf0, 0x3d, 0xef, 0x3f, 0x7b, 0xff, 0xbf, 0xee, 0x0e, 0xf0, 0x3e, 0x7e, 0x3f, 0xff, 
+	0xff, 0xfd, 0xf0, 0x3d, 0xef, 0x3f, 0x7b, 0xff, 0xb9, 0xee, 0x0e, 0xff, 0x3f, 0x7e, 0x3f, 0xff, 
+	0xff, 0xfd, 0xf0, 0x1d, 0xef, 0x1f, 0x5a, 0xff, 0xb9, 0xee, 0x0e, 0xff, 0x3f, 0xfe, 0x3f, 0xff, 
+	0xff, 0xfd, 0x90, 0x2d, 0x6f, 0x0f, 0x49, 0xff, 0xb9, 0xee, 0x0c, 0xff, 0x3f, 0xfe, 0x3f, 0xff, 
+	0xff, 0xfd, 0xd2, 0x18, 0xcf, 0x4f, 0x48, 0xfe, 0x39, 0xec, 0x0c, 0xff, 0x1f, 0xfe, 0x3f, 0xff, 
+	0xff, 0xfc, 0x03, 0x80, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x0f, 0xfe, 0x3f, 0xff, 
+	0xff, 0xfe, 0x03, 0x80, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x47, 0xfe, 0x7f, 0xff, 
+	0xff, 0xff, 0x03, 0xc0, 0x10, 0x60, 0x02, 0x00, 0x42, 0x00, 0x70, 0x40, 0x63, 0xfc, 0x3f, 0xff, 
+	0xff, 0xf7, 0x83, 0xe2, 0x18, 0x70, 0xc3, 0x00, 0xc6, 0x00, 0xf8, 0xc8, 0xf1, 0xf8, 0x37, 0xff, 
+	0xff, 0xff, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 
+	0xff, 0xfd, 0xc1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 
+	0x80, 0x01, 0xe1, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe7, 0xfe, 0x01, 0xe0, 0x01, 
+	0xff, 0xff, 0xf0, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe7, 0xff, 0x07, 0xff, 0xff, 
+	0x80, 0x00, 0x7f, 0xfc, 0xff, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xfc, 0xe3, 0xff, 0x8e, 0x80, 0x01, 
+	0x80, 0x00, 0x3f, 0xfc, 0x0c, 0x1c, 0x13, 0x9f, 0xe6, 0x60, 0xc0, 0xc1, 0xff, 0xfc, 0x00, 0x01, 
+	0x80, 0x00, 0x5f, 0xfc, 0xcd, 0xc8, 0x93, 0x3f, 0xe6, 0x64, 0x44, 0xe3, 0xff, 0xf0, 0x00, 0x03, 
+	0xff, 0xf8, 0x0f, 0xfc, 0xcf, 0xc9, 0xf0, 0x7f, 0xe6, 0x66, 0x4c, 0xe7, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0xfb, 0xe3, 0xfc, 0xcc, 0x09, 0xf0, 0xff, 0xe6, 0x66, 0x4c, 0xe7, 0xef, 0xff, 0xff, 0xff, 
+	0xff, 0xf2, 0x3b, 0xfc, 0xc9, 0xc9, 0xf0, 0x7f, 0xe6, 0x66, 0x4c, 0xe7, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0xf6, 0x0b, 0xfc, 0xc9, 0xc8, 0x91, 0x3f, 0xe0, 0x60, 0x40, 0xe1, 0xff, 0xff, 0x7f, 0xff, 
+	0xfb, 0xf4, 0xcb, 0xfc, 0xcc, 0x0c, 0x33, 0x10, 0x30, 0x60, 0xe0, 0xf1, 0xff, 0xff, 0xbf, 0xff, 
+	0xe5, 0xf4, 0x0a, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xdd, 0xf7, 0x5b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 
+	0x3e, 0xf1, 0xb3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xff, 0x7c, 0xe7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
+	0xed, 0x7e, 0x0f, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x00, 0x0f, 0xff, 0x47, 0xff, 0xff, 
+	0xfb, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xff, 0xf8, 0x99, 0xff, 0xff, 
+	0x6e, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x3f, 0xf8, 0x34, 0x7f, 0xff, 
+	0xd4, 0x5f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0x5f, 0xf3, 0x6d, 0x9f, 0xff, 
+	0x38, 0x6f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xef, 0xea, 0xaa, 0xaf, 0xff, 
+	0x00, 0xef, 0xfe, 0xf8, 0x1b, 0xff, 0xff, 0xff, 0xc0, 0x7f, 0xdd, 0xb3, 0xe5, 0x55, 0x57, 0xff, 
+	0x01, 0xa7, 0xfd, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xfc, 0x4a, 0xaa, 0xa3, 0xff, 
+	0x03, 0xf9, 0xf3, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xca, 0x89, 0x8a, 0x52, 0x48, 0xff, 
+	0x00, 0x36, 0xef, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0xa5, 0x55, 0x00, 0x00, 0x00, 0x7f, 
+	0x00, 0x0f, 0x1b, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf4, 0x92, 0x4a, 0x41, 0x08, 0x42, 0x0f, 
+	0x83, 0x01, 0xae, 0x07, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x76, 0x51, 0x24, 0x00, 0x00, 0x00, 0x03, 
+	0x87, 0x80, 0x1e, 0x01, 0xff, 0xff, 0xff, 0xff, 0xf3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
+	0x8f, 0x60, 0x1f, 0xe0, 0x7f, 0xff, 0xff, 0xff, 0xef, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 'Select', 128x10px
+const unsigned char epd_bitmap_Select [] PROGMEM = {
+	0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xc0, 0x30, 
+	0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x1f, 0xff, 0xff, 0xf0, 0x48, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf8, 0x88, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf9, 0x08, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xfa, 0x08, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xfa, 0x08, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf9, 0x08, 
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xff, 0xff, 0xf8, 0x88, 
+	0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x1f, 0xff, 0xff, 0xf0, 0x48, 
+	0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x07, 0xff, 0xff, 0xc0, 0x30
+};
+
+// 'GameHeader', 128x20px
+const unsigned char epd_bitmap_GameHeader [] PROGMEM = {
+	0x00, 0x00, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x03, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x2a, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0xdc, 0x00, 0x07, 0xc0, 0x00, 0x30, 0xbc, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x2f, 0xff, 0xf0, 0x6c, 0x07, 0xee, 0x6f, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x1f, 0xf8, 0x0f, 0xff, 0xfb, 0x91, 0x37, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x19, 0x2b, 0xf8, 0xfc, 0x03, 0xf0, 0xae, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x90, 0x66, 0xec, 0x60, 0x40, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x92, 0x42, 0x68, 0x66, 0x60, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x26, 0x97, 0x42, 0x09, 0xe7, 0xe0, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x1d, 0x01, 0x20, 0x97, 0xd2, 0x08, 0x61, 0xee, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x20, 0x97, 0xda, 0x08, 0x70, 0xc0, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x29, 0x20, 0x94, 0x42, 0xa9, 0xf8, 0x40, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x39, 0x2c, 0x96, 0x42, 0xe9, 0xec, 0x60, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x3d, 0x2c, 0xd0, 0x5a, 0xe8, 0x40, 0x60, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x7f, 0xee, 0xf8, 0xda, 0xec, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x01, 0xe7, 0xfb, 0xff, 0xff, 0xff, 0xf0, 0x40, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xe7, 0xdb, 0xff, 0xff, 0x9f, 0xd8, 0xe0, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x07, 0xff, 0x30, 0x00, 0x00, 0x00, 0x00, 0x07, 0x9f, 0xf8, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0x7f, 0xfc, 0x00, 0x00, 0x00
+};
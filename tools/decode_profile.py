@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Decodes the frame profiles GameSystem prints at game over.
+
+Build with ENABLE_PROFILER set in config.h, play, and save the Serial
+output. Every "Profile: N bytes" line followed by its hex lines is turned
+into a table of the frame phases and the slowest frames of that game.
+
+    python3 tools/decode_profile.py serial.log
+    python3 tools/decode_profile.py < serial.log
+"""
+
+import re
+import sys
+
+GAMES = ["SNAKE", "TETRIS", "FLAPPY BIRD", "2048", "BREAKOUT", "FROGGER", "HELICOPTER", "PAC-MAN"]
+PHASES = ["input", "update", "draw", "flush"]
+VERSION = 1
+
+HEADER = re.compile(r"Profile: (\d+) bytes")
+HEX_LINE = re.compile(r"^[0-9A-F]+$")
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.position = 0
+
+    def byte(self):
+        if self.position >= len(self.data):
+            raise ValueError("profile ends early")
+        value = self.data[self.position]
+        self.position += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return value
+            shift += 7
+
+
+def extract(lines):
+    """Byte strings of every profile in the log."""
+    lines = iter(lines)
+    for line in lines:
+        match = HEADER.search(line)
+        if not match:
+            continue
+        length = int(match.group(1))
+        text = ""
+        for line in lines:
+            line = line.strip()
+            if not HEX_LINE.match(line):
+                break
+            text += line
+            if len(text) >= length * 2:
+                break
+        yield bytes.fromhex(text[:length * 2])
+
+
+def decode(data):
+    r = Reader(data)
+    if r.byte() != ord("P") or r.byte() != ord("F"):
+        raise ValueError("not a profile")
+    version = r.byte()
+    if version != VERSION:
+        raise ValueError("profile version %d, expected %d" % (version, VERSION))
+    phases = r.byte()
+    buckets = r.byte()
+    profile = {"game": r.byte(), "frames": r.varint(), "buckets": buckets, "phases": []}
+
+    for _ in range(phases):
+        phase = {"total": r.varint(), "max": r.varint()}
+        first = r.byte()
+        count = r.byte()
+        counts = [0] * buckets
+        for b in range(first, first + count):
+            counts[b] = r.varint()
+        phase["counts"] = counts
+        profile["phases"].append(phase)
+
+    profile["worst"] = []
+    for _ in range(r.byte()):
+        frame = r.varint()
+        profile["worst"].append((frame, [r.varint() for _ in range(phases)]))
+    return profile
+
+
+def percentile(phase, percent):
+    """Upper edge of the bucket holding the percentile, at most the max."""
+    total = sum(phase["counts"])
+    rank = (total * percent + 99) // 100
+    seen = 0
+    for bucket, count in enumerate(phase["counts"][:-1]):
+        seen += count
+        if seen >= rank:
+            return min(1 << bucket, phase["max"])
+    return phase["max"]
+
+
+def name(index, names):
+    return names[index] if index < len(names) else "#%d" % index
+
+
+def report(profile):
+    frames = profile["frames"]
+    print("%s: %d frames" % (name(profile["game"], GAMES), frames))
+    print("  %-8s %8s %8s %8s %8s  (us)" % ("phase", "mean", "p50", "p99", "max"))
+    for index, phase in enumerate(profile["phases"]):
+        print("  %-8s %8d %8d %8d %8d" % (name(index, PHASES), phase["total"] // max(frames, 1),
+                                          percentile(phase, 50), percentile(phase, 99), phase["max"]))
+
+    print("  slowest frames:")
+    for frame, micros in sorted(profile["worst"], key=lambda w: -sum(w[1])):
+        parts = ", ".join("%s %d" % (name(i, PHASES), t) for i, t in enumerate(micros))
+        print("    frame %d: %d us (%s)" % (frame, sum(micros), parts))
+
+
+def main():
+    source = open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin
+    found = False
+    for data in extract(source):
+        report(decode(data))
+        found = True
+    if not found:
+        sys.exit("no profile found, build with ENABLE_PROFILER set")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Generates GameSystem/assets.cpp from the image2cpp arrays in tools/bitmaps.h.
+
+Every bitmap is turned into SSD1306 page columns, one byte per column with
+bit 0 the top row, and packed with PackBits so that the sketch can stream
+it into the framebuffer without a decode buffer.
+
+    python3 tools/make_assets.py > GameSystem/assets.cpp
+"""
+
+import os
+import re
+import sys
+
+SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "bitmaps.h")
+
+# // 'Name', WxHpx followed by its array
+BITMAP = re.compile(r"//\s*'(\w+)',\s*(\d+)x(\d+)px\s*\n\s*const unsigned char \w+\s*\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}")
+
+
+def parse(text):
+    for match in BITMAP.finditer(text):
+        name, width, height, body = match.groups()
+        data = [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", body)]
+        width, height = int(width), int(height)
+        if len(data) != (width + 7) // 8 * height:
+            sys.exit("%s: %d bytes, expected %dx%d" % (name, len(data), width, height))
+        yield name, width, height, data
+
+
+def to_pages(width, height, data):
+    """Row-major MSB-first bitmap to page-major columns."""
+    stride = (width + 7) // 8
+    columns = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and data[y * stride + x // 8] & (0x80 >> (x % 8)):
+                    byte |= 1 << bit
+            columns.append(byte)
+    return columns
+
+
+def packbits(data):
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += [257 - run, data[i]]
+            i += run
+            continue
+
+        # Literal bytes up to the next run of three
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out += [i - start - 1] + data[start:i]
+    return out
+
+
+def unpackbits(data, length):
+    out = []
+    i = 0
+    while len(out) < length:
+        header = data[i]
+        if header < 128:
+            out += data[i + 1:i + 2 + header]
+            i += 2 + header
+        else:
+            out += [data[i + 1]] * (257 - header)
+            i += 2
+    return out
+
+
+def main():
+    with open(SOURCE) as f:
+        bitmaps = list(parse(f.read()))
+
+    print("// Generated by tools/make_assets.py, do not edit")
+    print('#include "assets.h"')
+
+    for name, width, height, data in bitmaps:
+        columns = to_pages(width, height, data)
+        packed = packbits(columns)
+        assert unpackbits(packed, len(columns)) == columns
+
+        lines = []
+        for i in range(0, len(packed), 16):
+            lines.append("  " + ", ".join("0x%02X" % b for b in packed[i:i + 16]))
+
+        symbol = name[0].lower() + name[1:]
+        print()
+        print("// %s, %dx%d, %d bytes packed from %d" % (name, width, height, len(packed), len(data)))
+        print("const uint8_t %sData[] PROGMEM = {" % symbol)
+        print(",\n".join(lines))
+        print("};")
+        print("const Asset asset%s = {%d, %d, %sData};" % (name, width, height, symbol))
+
+
+if __name__ == "__main__":
+    main()
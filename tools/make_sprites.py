@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Generates GameSystem/sprites.cpp.
+
+Each sprite is drawn here with the same Adafruit GFX algorithms the games
+used to call every frame, then stored as SSD1306 page columns: for every
+column one byte of pixel values and one byte of the pixels it touches.
+
+    python3 tools/make_sprites.py > GameSystem/sprites.cpp
+"""
+
+WHITE, BLACK = 1, 0
+
+
+class Canvas:
+    """Records the last color written to each pixel, relative to an anchor."""
+
+    def __init__(self):
+        self.pixels = {}
+
+    def pixel(self, x, y, color):
+        self.pixels[(x, y)] = color
+
+    def vline(self, x, y, h, color):
+        for row in range(y, y + h):
+            self.pixel(x, row, color)
+
+    def fill_rect(self, x, y, w, h, color):
+        for column in range(x, x + w):
+            self.vline(column, y, h, color)
+
+    def fill_circle(self, x0, y0, r, color):
+        # Adafruit_GFX::fillCircle and fillCircleHelper(corners = 3, delta = 0)
+        self.vline(x0, y0 - r, 2 * r + 1, color)
+        f, ddf_x, ddf_y, x, y = 1 - r, 1, -2 * r, 0, r
+        px, py = x, y
+        delta = 1
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddf_y += 2
+                f += ddf_y
+            x += 1
+            ddf_x += 2
+            f += ddf_x
+            if x < y + 1:
+                self.vline(x0 + x, y0 - y, 2 * y + delta, color)
+                self.vline(x0 - x, y0 - y, 2 * y + delta, color)
+            if y != py:
+                self.vline(x0 + py, y0 - px, 2 * px + delta, color)
+                self.vline(x0 - py, y0 - px, 2 * px + delta, color)
+                py = y
+            px = x
+
+    def line(self, x0, y0, x1, y1, color):
+        # Adafruit_GFX::drawLine / writeLine
+        if x0 == x1:
+            for y in range(min(y0, y1), max(y0, y1) + 1):
+                self.pixel(x0, y, color)
+            return
+        if y0 == y1:
+            for x in range(min(x0, x1), max(x0, x1) + 1):
+                self.pixel(x, y0, color)
+            return
+        steep = abs(y1 - y0) > abs(x1 - x0)
+        if steep:
+            x0, y0, x1, y1 = y0, x0, y1, x1
+        if x0 > x1:
+            x0, x1, y0, y1 = x1, x0, y1, y0
+        dx, dy = x1 - x0, abs(y1 - y0)
+        err = dx // 2
+        ystep = 1 if y0 < y1 else -1
+        while x0 <= x1:
+            if steep:
+                self.pixel(y0, x0, color)
+            else:
+                self.pixel(x0, y0, color)
+            err -= dy
+            if err < 0:
+                y0 += ystep
+                err += dx
+            x0 += 1
+
+
+def pacman(direction):
+    # PacManGame::drawPacMan, anchored at the cell center
+    c = Canvas()
+    c.fill_circle(0, 0, 3, WHITE)
+    ends = {0: ((2, -1), (2, 1)), 1: ((-1, 2), (1, 2)),
+            2: ((-2, -1), (-2, 1)), 3: ((-1, -2), (1, -2))}[direction]
+    for x, y in ends:
+        c.line(0, 0, x, y, BLACK)
+    return c
+
+
+def ghost():
+    # PacManGame::drawGhosts, anchored at the cell center
+    c = Canvas()
+    c.fill_circle(0, -1, 3, WHITE)
+    c.fill_rect(-3, 0, 6, 3, WHITE)
+    for x, y in ((-2, 3), (0, 2), (2, 3)):
+        c.pixel(x, y, WHITE)
+    for x, y in ((-1, -2), (1, -2)):
+        c.pixel(x, y, BLACK)
+    return c
+
+
+def dot():
+    # Radius 1 circle: Pac-Man dots and Snake food, anchored at the center
+    c = Canvas()
+    c.fill_circle(0, 0, 1, WHITE)
+    return c
+
+
+def bird():
+    # FlappyGame::drawBird, anchored at the center
+    c = dot()
+    c.pixel(0, 0, BLACK)
+    return c
+
+
+def frog():
+    # FroggerGame::drawFrog, anchored at the top left (FROG_SIZE 4)
+    c = Canvas()
+    c.fill_rect(0, 0, 4, 4, WHITE)
+    c.pixel(1, 1, BLACK)
+    c.pixel(3, 1, BLACK)
+    return c
+
+
+def car():
+    # FroggerGame::drawCars, anchored at the top left
+    c = Canvas()
+    c.fill_rect(0, 0, 8, 6, WHITE)
+    c.pixel(2, 2, BLACK)
+    c.pixel(6, 2, BLACK)
+    return c
+
+
+def encode(name, canvas, sprite_id):
+    xs = [x for x, _ in canvas.pixels]
+    ys = [y for _, y in canvas.pixels]
+    left, top = min(xs), min(ys)
+    width, height = max(xs) - left + 1, max(ys) - top + 1
+    assert height <= 8, name
+
+    data = []
+    for column in range(width):
+        bits = mask = 0
+        for row in range(height):
+            color = canvas.pixels.get((left + column, top + row))
+            if color is not None:
+                mask |= 1 << row
+                if color == WHITE:
+                    bits |= 1 << row
+        data += [bits, mask]
+
+    body = ", ".join("0x%02X" % b for b in data)
+    array = "const uint8_t %sData[] PROGMEM = {%s};\n" % (name, body)
+    entry = "{%d, %d, %d, %d, %d, %sData}" % (sprite_id, width, height, -left, -top, name)
+    return array, entry
+
+
+def main():
+    print("// Generated by tools/make_sprites.py, do not edit")
+    print('#include "sprites.h"')
+    print()
+
+    arrays, entries = [], {}
+    sprites = [("pacmanRight", pacman(0)), ("pacmanDown", pacman(1)),
+               ("pacmanLeft", pacman(2)), ("pacmanUp", pacman(3)),
+               ("ghost", ghost()), ("dot", dot()), ("bird", bird()),
+               ("frog", frog()), ("car", car())]
+    for sprite_id, (name, canvas) in enumerate(sprites):
+        array, entries[name] = encode(name, canvas, sprite_id)
+        arrays.append(array)
+
+    print("".join(arrays))
+    print("const Sprite spritePacman[4] = {")
+    print("  " + ",\n  ".join(entries[n] for n in
+                             ("pacmanRight", "pacmanDown", "pacmanLeft", "pacmanUp")))
+    print("};")
+    for name in ("ghost", "dot", "bird", "frog", "car"):
+        print("const Sprite sprite%s = %s;" % (name[0].upper() + name[1:], entries[name]))
+
+    # Lets the display list store a sprite as a one byte id
+    print()
+    print("const Sprite* const spriteTable[SPRITE_COUNT] = {")
+    references = ["&spritePacman[%d]" % i for i in range(4)]
+    references += ["&sprite%s" % n for n in ("Ghost", "Dot", "Bird", "Frog", "Car")]
+    print("  " + ",\n  ".join(references))
+    print("};")
+
+
+if __name__ == "__main__":
+    main()